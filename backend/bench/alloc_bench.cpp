@@ -0,0 +1,54 @@
+#include "alloc_counter.h"
+#include "bench_util.h"
+#include "../include/board.h"
+#include "../include/ai.h"
+#include <iostream>
+#include <vector>
+
+// Counts heap allocations per search node.
+// Positions are reached by seeded random playouts so runs are reproducible.
+
+int main() {
+    struct Case { const char* name; int plies; int depth; };
+    const Case cases[] = {
+        {"opening", 0, 2},
+        {"early", 4, 3},
+        {"middle", 12, 3},
+        {"late", 24, 4},
+    };
+
+    bool clean = true;
+
+    for (const Case& c : cases) {
+        Player side;
+        Board board = randomPosition(c.plies, 2024, side);
+        AI ai(side, c.depth);
+
+        // Move generation on its own
+        long long before = allocationCount();
+        for (int i = 0; i < 1000; i++) {
+            MoveList moves;
+            board.generateMoves(side, moves);
+        }
+        long long genAllocs = allocationCount() - before;
+
+        // Full search
+        before = allocationCount();
+        ai.getBestMove(board);
+        long long searchAllocs = allocationCount() - before;
+        long long nodes = ai.getNodesEvaluated();
+
+        std::cout << c.name << " depth " << c.depth
+                  << ": movegen allocs/call " << (genAllocs / 1000.0)
+                  << ", search allocs " << searchAllocs
+                  << " over " << nodes << " nodes ("
+                  << (nodes ? double(searchAllocs) / nodes : 0.0) << "/node)" << std::endl;
+
+        if (genAllocs != 0 || searchAllocs != 0) {
+            clean = false;
+        }
+    }
+
+    std::cout << (clean ? "PASS: zero allocations per node" : "FAIL: search allocates") << std::endl;
+    return clean ? 0 : 1;
+}
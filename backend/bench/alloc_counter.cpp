@@ -0,0 +1,89 @@
+#include "alloc_counter.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<long long> allocations(0);
+
+// Over-aligned blocks (alignas above the default, such as the 64-byte
+// transposition table buckets): malloc enough to align by hand and keep
+// the malloc pointer just before the aligned block. std::aligned_alloc is
+// not available on every toolchain this builds with.
+void* alignedAlloc(std::size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    if (void* raw = std::malloc(size + align + sizeof(void*))) {
+        std::uintptr_t start = reinterpret_cast<std::uintptr_t>(raw) + sizeof(void*);
+        void* ptr = reinterpret_cast<void*>((start + align - 1) & ~(static_cast<std::uintptr_t>(align) - 1));
+        static_cast<void**>(ptr)[-1] = raw;
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void alignedFree(void* ptr) {
+    if (ptr) {
+        std::free(static_cast<void**>(ptr)[-1]);
+    }
+}
+
+} // namespace
+
+long long allocationCount() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    std::free(ptr);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    return alignedAlloc(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return alignedAlloc(size, alignment);
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+    alignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::align_val_t) noexcept {
+    alignedFree(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+    alignedFree(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept {
+    alignedFree(ptr);
+}
@@ -0,0 +1,12 @@
+#ifndef ALLOC_COUNTER_H
+#define ALLOC_COUNTER_H
+
+// Global allocation counter for benchmarks.
+// Linking alloc_counter.cpp replaces the global operator new/delete, the
+// over-aligned (std::align_val_t) forms included, so every heap allocation
+// in the process is counted.
+
+// Number of operator new calls since program start
+long long allocationCount();
+
+#endif // ALLOC_COUNTER_H
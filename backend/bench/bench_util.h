@@ -0,0 +1,50 @@
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include "../include/board.h"
+#include <iostream>
+#include <random>
+#include <streambuf>
+
+// Fixtures shared by the benchmarks
+
+inline Player otherPlayer(Player player) {
+    return (player == Player::PLAYER1) ? Player::PLAYER2 : Player::PLAYER1;
+}
+
+// Seeded random playout, so runs are reproducible; returns the side to move
+// in side. Stops early if the side to move is stuck.
+inline Board randomPosition(int plies, unsigned seed, Player& side) {
+    std::mt19937 rng(seed);
+    Board board;
+    side = Player::PLAYER1;
+    for (int i = 0; i < plies; i++) {
+        MoveList moves;
+        board.generateMoves(side, moves);
+        if (moves.empty()) {
+            break;
+        }
+        board.applyMove(moves[rng() % moves.size()], side);
+        side = otherPlayer(side);
+    }
+    return board;
+}
+
+// Debug builds log every search to std::cout; discard it while in scope so
+// the report stays readable
+class QuietOutput {
+private:
+    std::streambuf* saved;
+
+public:
+    QuietOutput() : saved(std::cout.rdbuf(nullptr)) {}
+    ~QuietOutput() {
+        std::cout.rdbuf(saved);
+        std::cout.clear();
+    }
+
+    QuietOutput(const QuietOutput&) = delete;
+    QuietOutput& operator=(const QuietOutput&) = delete;
+};
+
+#endif // BENCH_UTIL_H
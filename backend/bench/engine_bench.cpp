@@ -0,0 +1,253 @@
+#include "alloc_counter.h"
+#include "bench_util.h"
+#include "../include/board.h"
+#include "../include/ai.h"
+#include <chrono>
+#include <cstdlib>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Baseline timings of the engine's building blocks on a fixed corpus of
+// early, middle and late game positions: move generation, move validation,
+// applying moves, static evaluation and fixed-depth searches.
+// Reports ns/op and allocations/op (plus nodes/sec for searches) as a table,
+// JSON or CSV; diff the machine-readable output between builds.
+// Usage: engine_bench [table|json|csv] [min ms per benchmark]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct BenchPosition {
+    Board board;
+    Player side;
+};
+
+// Seeded random playout; positions where the side to move is stuck are skipped
+std::vector<BenchPosition> corpus(int minPlies, int maxPlies, unsigned seed) {
+    std::vector<BenchPosition> positions;
+    for (int plies = minPlies; plies <= maxPlies; plies++) {
+        for (unsigned game = 0; game < 4; game++) {
+            BenchPosition position;
+            position.board = randomPosition(plies, seed + game * 101 + plies, position.side);
+            if (position.board.canPlayerMove(position.side)) {
+                positions.push_back(position);
+            }
+        }
+    }
+    return positions;
+}
+
+struct Result {
+    std::string name;
+    std::string phase;
+    long long ops;
+    double nsPerOp;
+    double allocsPerOp;
+    long long nodes;        // Searches only
+    double nodesPerSec;
+};
+
+// Repeat batch (which returns the number of operations it did) until
+// minMs have passed
+template <typename Batch>
+Result measure(const std::string& name, const std::string& phase, double minMs, Batch&& batch) {
+    long long ops = 0;
+    long long allocs = 0;
+    double ns = 0.0;
+    while (ns < minMs * 1e6) {
+        long long allocsBefore = allocationCount();
+        auto start = Clock::now();
+        ops += batch();
+        ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        allocs += allocationCount() - allocsBefore;
+    }
+    return Result{name, phase, ops, ns / ops, static_cast<double>(allocs) / ops, 0, 0.0};
+}
+
+volatile long long sink = 0;
+
+void benchPhase(const std::string& phase, const std::vector<BenchPosition>& positions, int depth,
+                double minMs, std::vector<Result>& results) {
+    // Candidate moves for isValidMove: all legal moves plus as many
+    // random (mostly illegal) ones
+    std::vector<std::vector<Move>> legal;
+    std::vector<std::vector<Move>> candidates;
+    std::mt19937 rng(7);
+    for (const BenchPosition& p : positions) {
+        legal.push_back(p.board.getAllPossibleMoves(p.side));
+        std::vector<Move> mixed = legal.back();
+        Position from = p.board.getPlayerPosition(p.side);
+        for (size_t i = 0, n = mixed.size(); i < n; i++) {
+            mixed.push_back(Move(from, positionOf(rng() % NUM_SQUARES), positionOf(rng() % NUM_SQUARES)));
+        }
+        candidates.push_back(mixed);
+    }
+
+    results.push_back(measure("getAllPossibleMoves", phase, minMs, [&]() {
+        for (const BenchPosition& p : positions) {
+            sink = sink + static_cast<long long>(p.board.getAllPossibleMoves(p.side).size());
+        }
+        return static_cast<long long>(positions.size());
+    }));
+
+    results.push_back(measure("generateMoves", phase, minMs, [&]() {
+        for (const BenchPosition& p : positions) {
+            MoveList moves;
+            p.board.generateMoves(p.side, moves);
+            sink = sink + static_cast<long long>(moves.size());
+        }
+        return static_cast<long long>(positions.size());
+    }));
+
+    results.push_back(measure("isValidMove", phase, minMs, [&]() {
+        long long ops = 0;
+        for (size_t i = 0; i < positions.size(); i++) {
+            for (const Move& move : candidates[i]) {
+                sink = sink + positions[i].board.isValidMove(move, positions[i].side);
+            }
+            ops += static_cast<long long>(candidates[i].size());
+        }
+        return ops;
+    }));
+
+    // applyMove validates and mutates, so each call works on a fresh copy
+    results.push_back(measure("applyMove", phase, minMs, [&]() {
+        long long ops = 0;
+        for (size_t i = 0; i < positions.size(); i++) {
+            for (const Move& move : legal[i]) {
+                Board board = positions[i].board;
+                sink = sink + board.applyMove(move, positions[i].side);
+            }
+            ops += static_cast<long long>(legal[i].size());
+        }
+        return ops;
+    }));
+
+    results.push_back(measure("makeMove+unmakeMove", phase, minMs, [&]() {
+        long long ops = 0;
+        for (size_t i = 0; i < positions.size(); i++) {
+            Board board = positions[i].board;
+            for (const Move& move : legal[i]) {
+                UndoInfo undo;
+                board.makeMove(move, positions[i].side, undo);
+                board.unmakeMove(positions[i].side, undo);
+            }
+            sink = sink + static_cast<long long>(board.getHash());
+            ops += static_cast<long long>(legal[i].size());
+        }
+        return ops;
+    }));
+
+    for (EvalMode mode : {EvalMode::MOBILITY, EvalMode::TERRITORY}) {
+        AI ai1(Player::PLAYER1, depth, 0);
+        AI ai2(Player::PLAYER2, depth, 0);
+        ai1.setEvalMode(mode);
+        ai2.setEvalMode(mode);
+        std::string name = (mode == EvalMode::TERRITORY) ? "evaluate(territory)" : "evaluate(mobility)";
+        results.push_back(measure(name, phase, minMs, [&]() {
+            for (const BenchPosition& p : positions) {
+                sink = sink + ((p.side == Player::PLAYER1) ? ai1 : ai2).evaluate(p.board);
+            }
+            return static_cast<long long>(positions.size());
+        }));
+    }
+
+    // One cold search per position: the table and ordering history are
+    // cleared (outside the timing) so every run does the same work
+    AI ai1(Player::PLAYER1, depth);
+    AI ai2(Player::PLAYER2, depth);
+    long long searches = 0;
+    long long nodes = 0;
+    long long allocs = 0;
+    double ns = 0.0;
+    QuietOutput quiet;
+    while (ns < minMs * 1e6) {
+        for (const BenchPosition& p : positions) {
+            AI& ai = (p.side == Player::PLAYER1) ? ai1 : ai2;
+            ai.clearHash();
+            long long allocsBefore = allocationCount();
+            auto start = Clock::now();
+            ai.getBestMove(p.board);
+            ns += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            allocs += allocationCount() - allocsBefore;
+            nodes += ai.getNodesEvaluated();
+            searches++;
+        }
+    }
+    results.push_back(Result{"getBestMove(depth " + std::to_string(depth) + ")", phase, searches,
+                             ns / searches, static_cast<double>(allocs) / searches, nodes / searches,
+                             nodes / (ns / 1e9)});
+}
+
+void printTable(const std::vector<Result>& results) {
+    std::cout << std::left << std::setw(24) << "benchmark" << std::setw(8) << "phase" << std::right
+              << std::setw(14) << "ns/op" << std::setw(12) << "allocs/op" << std::setw(14) << "nodes/sec"
+              << std::endl;
+    for (const Result& r : results) {
+        std::cout << std::left << std::setw(24) << r.name << std::setw(8) << r.phase << std::right
+                  << std::fixed << std::setprecision(1) << std::setw(14) << r.nsPerOp
+                  << std::setprecision(2) << std::setw(12) << r.allocsPerOp;
+        if (r.nodes) {
+            std::cout << std::setprecision(0) << std::setw(14) << r.nodesPerSec;
+        }
+        std::cout << std::endl;
+    }
+}
+
+void printJson(const std::vector<Result>& results) {
+    std::cout << "[" << std::endl;
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        std::cout << "  {\"benchmark\": \"" << r.name << "\", \"phase\": \"" << r.phase
+                  << "\", \"ops\": " << r.ops << ", \"ns_per_op\": " << r.nsPerOp
+                  << ", \"allocs_per_op\": " << r.allocsPerOp << ", \"nodes_per_op\": " << r.nodes
+                  << ", \"nodes_per_sec\": " << r.nodesPerSec << "}"
+                  << (i + 1 < results.size() ? "," : "") << std::endl;
+    }
+    std::cout << "]" << std::endl;
+}
+
+void printCsv(const std::vector<Result>& results) {
+    std::cout << "benchmark,phase,ops,ns_per_op,allocs_per_op,nodes_per_op,nodes_per_sec" << std::endl;
+    for (const Result& r : results) {
+        std::cout << r.name << "," << r.phase << "," << r.ops << "," << r.nsPerOp << "," << r.allocsPerOp
+                  << "," << r.nodes << "," << r.nodesPerSec << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string format = (argc > 1) ? argv[1] : "table";
+    double minMs = (argc > 2) ? std::atof(argv[2]) : 200.0;
+    if (format != "table" && format != "json" && format != "csv") {
+        std::cerr << "Usage: engine_bench [table|json|csv] [min ms per benchmark]" << std::endl;
+        return 2;
+    }
+
+    struct Phase { const char* name; int minPlies; int maxPlies; int depth; };
+    const Phase phases[] = {
+        {"early", 0, 6, 4},
+        {"middle", 12, 18, 5},
+        {"late", 24, 30, 6},
+    };
+
+    std::vector<Result> results;
+    for (const Phase& phase : phases) {
+        benchPhase(phase.name, corpus(phase.minPlies, phase.maxPlies, 2024), phase.depth, minMs, results);
+    }
+
+    if (format == "json") {
+        printJson(results);
+    } else if (format == "csv") {
+        printCsv(results);
+    } else {
+        printTable(results);
+    }
+    return 0;
+}
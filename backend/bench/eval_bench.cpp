@@ -0,0 +1,119 @@
+#include "bench_util.h"
+#include "../include/board.h"
+#include "../include/ai.h"
+#include <chrono>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <vector>
+
+// Compares EvalMode::TERRITORY against EvalMode::MOBILITY:
+// cost of the evaluation terms, search speed at equal depth, and a match
+// between the two from random openings with colors swapped.
+// Usage: eval_bench [game pairs] [match depth]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const char* modeName(EvalMode mode) {
+    return (mode == EvalMode::TERRITORY) ? "territory" : "mobility";
+}
+
+// Plays one game; returns the winner
+Player playGame(const Board& start, Player side, EvalMode player1Mode, EvalMode player2Mode, int depth) {
+    AI ai1(Player::PLAYER1, depth);
+    AI ai2(Player::PLAYER2, depth);
+    ai1.setEvalMode(player1Mode);
+    ai2.setEvalMode(player2Mode);
+
+    Board board = start;
+    while (board.canPlayerMove(side)) {
+        AI& ai = (side == Player::PLAYER1) ? ai1 : ai2;
+        board.applyMove(ai.getBestMove(board), side);
+        side = otherPlayer(side);
+    }
+    return otherPlayer(side);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int pairs = (argc > 1) ? std::atoi(argv[1]) : 20;
+    int matchDepth = (argc > 2) ? std::atoi(argv[2]) : 3;
+
+    // Positions from every phase of the game
+    std::vector<Board> positions;
+    for (unsigned seed = 1; seed <= 200; seed++) {
+        Player side;
+        positions.push_back(randomPosition(static_cast<int>(seed % 30), seed, side));
+    }
+
+    // 1. Cost of the evaluation terms
+    const int rounds = 5000;
+    volatile long long sink = 0;
+    auto start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const Board& board : positions) {
+            sink = sink + board.getMobility(Player::PLAYER1) - board.getMobility(Player::PLAYER2);
+        }
+    }
+    double mobilityNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; r++) {
+        for (const Board& board : positions) {
+            Territory territory = board.getTerritory();
+            sink = sink + territory.player1 - territory.player2;
+        }
+    }
+    double territoryNs = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    double calls = static_cast<double>(rounds) * positions.size();
+    std::cout << "Evaluation terms (" << positions.size() << " positions):" << std::endl;
+    std::cout << "  mobility difference: " << mobilityNs / calls << " ns/call" << std::endl;
+    std::cout << "  territory:           " << territoryNs / calls << " ns/call" << std::endl;
+
+    // 2. Search speed at equal depth
+    std::cout << "Search at depth 4 (20 positions):" << std::endl;
+    for (EvalMode mode : {EvalMode::MOBILITY, EvalMode::TERRITORY}) {
+        long long nodes = 0;
+        start = Clock::now();
+        for (unsigned seed = 1; seed <= 20; seed++) {
+            Player side;
+            Board board = randomPosition(static_cast<int>(seed % 24), seed, side);
+            AI ai(side, 4);
+            ai.setEvalMode(mode);
+            QuietOutput quiet;
+            ai.getBestMove(board);
+            nodes += ai.getNodesEvaluated();
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        std::cout << "  " << modeName(mode) << ": " << nodes << " nodes, " << seconds * 1000 << " ms, "
+                  << static_cast<long long>(nodes / seconds) << " nodes/sec" << std::endl;
+    }
+
+    // 3. Match: territory vs mobility, each opening played with both colors
+    int wins = 0;
+    int losses = 0;
+    for (int pair = 0; pair < pairs; pair++) {
+        Player side;
+        Board opening = randomPosition(4, 1000 + pair, side);
+        QuietOutput quiet;
+        for (int swap = 0; swap < 2; swap++) {
+            Player territoryPlayer = swap ? Player::PLAYER2 : Player::PLAYER1;
+            Player winner = swap ? playGame(opening, side, EvalMode::MOBILITY, EvalMode::TERRITORY, matchDepth)
+                                 : playGame(opening, side, EvalMode::TERRITORY, EvalMode::MOBILITY, matchDepth);
+            if (winner == territoryPlayer) {
+                wins++;
+            } else {
+                losses++;
+            }
+        }
+    }
+
+    int games = wins + losses;
+    std::cout << "Match at depth " << matchDepth << ", territory vs mobility: +" << wins << " -" << losses
+              << " (" << (games ? 100.0 * wins / games : 0.0) << "%)" << std::endl;
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "bench_util.h"
+#include "../include/board.h"
+#include "../include/ai.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// Nodes and time of SearchAlgorithm::NEGAMAX_PVS and MTDF against the
+// original MINMAX search at equal depth on a fixed set of positions.
+// All must agree on the score of every position; the exit code is 1 if not.
+// Usage: search_bench [depth] [positions]
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Result {
+    long long nodes;
+    int score;
+    double ms;
+};
+
+Result search(const Board& board, Player side, int depth, SearchAlgorithm algorithm) {
+    AI ai(side, depth);
+    ai.setSearchAlgorithm(algorithm);
+
+    QuietOutput quiet;
+    auto start = Clock::now();
+    ai.getBestMove(board);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    return Result{ai.getNodesEvaluated(), ai.getLastScore(), ms};
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int depth = (argc > 1) ? std::atoi(argv[1]) : 5;
+    int count = (argc > 2) ? std::atoi(argv[2]) : 16;
+
+    const SearchAlgorithm algorithms[] = {
+        SearchAlgorithm::MINMAX, SearchAlgorithm::NEGAMAX_PVS, SearchAlgorithm::MTDF
+    };
+    const char* names[] = {"minmax", "negamax+pvs", "mtd(f)"};
+    constexpr int NUM_ALGORITHMS = 3;
+
+    long long totalNodes[NUM_ALGORITHMS] = {};
+    double totalMs[NUM_ALGORITHMS] = {};
+    int mismatches = 0;
+
+    std::cout << "pos plies   score   nodes (minmax / negamax+pvs / mtd(f))" << std::endl;
+    for (int i = 0; i < count; i++) {
+        int plies = 1 + (i * 2) % 29;
+        Player side;
+        Board board = randomPosition(plies, 100 + i, side);
+        if (!board.canPlayerMove(side)) {
+            continue;
+        }
+
+        Result results[NUM_ALGORITHMS];
+        for (int a = 0; a < NUM_ALGORITHMS; a++) {
+            results[a] = search(board, side, depth, algorithms[a]);
+            totalNodes[a] += results[a].nodes;
+            totalMs[a] += results[a].ms;
+        }
+
+        std::cout << i << "   " << plies << "   " << results[0].score << "   "
+                  << results[0].nodes << " / " << results[1].nodes << " / " << results[2].nodes;
+        for (int a = 1; a < NUM_ALGORITHMS; a++) {
+            if (results[a].score != results[0].score) {
+                std::cout << "  MISMATCH " << names[a] << " " << results[a].score;
+                mismatches++;
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    std::cout << "Depth " << depth << " totals:" << std::endl;
+    for (int a = 0; a < NUM_ALGORITHMS; a++) {
+        std::cout << "  " << names[a] << ": " << totalNodes[a] << " nodes, " << totalMs[a] << " ms";
+        if (a > 0 && totalNodes[0]) {
+            std::cout << " (" << 100.0 * (totalNodes[0] - totalNodes[a]) / totalNodes[0] << "% fewer nodes)";
+        }
+        std::cout << std::endl;
+    }
+
+    return mismatches ? 1 : 0;
+}
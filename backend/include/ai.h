@@ -4,22 +4,303 @@
 #include "board.h"
 #include "game.h"
 #include "types.h"
+#include "tt.h"
+#include "movepick.h"
+#include "endgame.h"
+#include "book.h"
+#include "ybwc.h"
+#include <atomic>
+#include <chrono>
 #include <limits>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+// Terminal scores: a win is WIN_SCORE plus the remaining depth
+constexpr int WIN_SCORE = 100000;
+
+// Deepest search supported; scores beyond WIN_SCORE - MAX_SEARCH_DEPTH are wins/losses
+constexpr int MAX_SEARCH_DEPTH = MAX_PLY;
+
+// Bound on all search scores (safe to negate, unlike INT_MIN)
+constexpr int SCORE_INFINITY = 1000000;
+
+// Half-width of the first aspiration window around the previous iteration's score
+constexpr int ASPIRATION_WINDOW = 25;
+
+// Default transposition table size in megabytes
+constexpr int DEFAULT_HASH_MB = 16;
+
+// Nodes between clock checks in a timed search (power of two)
+constexpr long long TIME_CHECK_INTERVAL = 1024;
+
+// Limits of the background search while pondering: this many plies past
+// the depth limit, and this many times the time budget (if set), so a long
+// think by the opponent does not keep a core busy and the table growing
+constexpr int PONDER_EXTRA_DEPTH = 2;
+constexpr int PONDER_TIME_FACTOR = 4;
+
+// Upper bound on search threads
+constexpr int MAX_THREADS = 256;
+
+// Young Brothers Wait: only nodes this close to the root with at least
+// this much depth left are split between threads
+constexpr int YBWC_MAX_SPLIT_PLY = 2;
+constexpr int YBWC_MIN_SPLIT_DEPTH = 2;
+
+// How extra search threads are used
+enum class ParallelMode {
+    LAZY_SMP,   // Independent searches sharing the transposition table
+    YBWC        // Split-point search: siblings stolen from work deques
+};
+
+// Weight of one cell of territory lead in EvalMode::TERRITORY
+constexpr int TERRITORY_WEIGHT = 4;
+
+// Tree search used for each iteration
+enum class SearchAlgorithm {
+    MINMAX,         // Max/min alpha-beta with the full window
+    NEGAMAX_PVS,    // Negamax, principal variation search, aspiration windows
+    MTDF            // Negamax zero-window passes converging on the score (MTD(f))
+};
+
+// Leaf evaluation used by the search
+enum class EvalMode {
+    MOBILITY,   // Mobility and center distance
+    TERRITORY   // Same plus the Voronoi territory difference
+};
+
+// Search state owned by one thread. Thread 0 is the main thread; helpers
+// share only the transposition table with it (Lazy SMP).
+struct SearchWorker {
+    int id;                     // 0 = main thread
+    Board board;                // Working board, mutated in place
+    OrderingTables ordering;    // Killer and history tables for move ordering
+    EndgameSolver endgame;      // Exact results of separated positions
+    WorkDeque deque;            // YBWC tasks created by this thread
+    SplitPoint* currentSplit;   // Split point of the YBWC task being run, if any
+
+    // Per-thread counters, summed after the search
+    long long nodes;
+    long long betaCutoffs;      // Cutoffs
+    long long firstMoveCutoffs; // Cutoffs by the first move searched
+    long long leafEvals;        // Static evaluations at the horizon
+    long long hashProbes;       // Transposition table lookups
+    long long hashHits;         // Lookups that found the position
+    int maxPly;                 // Deepest ply visited
+
+    // Copy of nodes refreshed every TIME_CHECK_INTERVAL nodes, readable by
+    // other threads while the search runs (progress reports)
+    std::atomic<long long> publishedNodes;
+
+    explicit SearchWorker(int workerId)
+        : id(workerId), currentSplit(nullptr), nodes(0), betaCutoffs(0), firstMoveCutoffs(0),
+          leafEvals(0), hashProbes(0), hashHits(0), maxPly(0), publishedNodes(0) {}
+
+    void resetCounters() {
+        nodes = 0;
+        betaCutoffs = 0;
+        firstMoveCutoffs = 0;
+        leafEvals = 0;
+        hashProbes = 0;
+        hashHits = 0;
+        maxPly = 0;
+        publishedNodes = 0;
+    }
+};
+
+// Snapshot of a running search (see AI::getProgress)
+struct SearchProgress {
+    int depth;          // Last completed iteration, 0 if none yet
+    int score;          // Its score (AI's point of view)
+    Move bestMove;      // Its best move (invalid while depth is 0)
+    long long nodes;    // Nodes searched so far by all threads (approximate)
+};
+
+// One completed iteration of iterative deepening
+struct IterationStats {
+    int depth;
+    int score;          // AI's point of view
+    long long nodes;    // Nodes of this iteration, all threads (approximate with helpers)
+    double timeMs;      // Time of this iteration
+};
+
+// Statistics of the last search (see AI::getLastSearchStats)
+struct SearchStats {
+    long long nodes;            // All threads
+    long long leafEvals;        // Static evaluations at the horizon
+    long long betaCutoffs;
+    long long firstMoveCutoffs; // Cutoffs by the first move searched
+    long long hashProbes;
+    long long hashHits;
+    int completedDepth;         // Last completed iteration
+    int maxPly;                 // Deepest ply visited by any thread
+    double timeMs;
+    bool fromBook;              // The move came from the opening book (no search)
+    int iterationCount;
+    IterationStats iterations[MAX_SEARCH_DEPTH];
+
+    double firstMoveCutoffRate() const {
+        return betaCutoffs ? static_cast<double>(firstMoveCutoffs) / betaCutoffs : 0.0;
+    }
+
+    // Nodes of the last iteration over those of the one before (0 with
+    // fewer than two iterations)
+    double effectiveBranchingFactor() const {
+        if (iterationCount < 2 || iterations[iterationCount - 2].nodes == 0) {
+            return 0.0;
+        }
+        return static_cast<double>(iterations[iterationCount - 1].nodes) /
+               iterations[iterationCount - 2].nodes;
+    }
+};
+
+// Write stats as one line of JSON (no trailing newline)
+void writeSearchStatsJson(std::ostream& out, const SearchStats& stats);
 
 class AI {
 private:
     Player aiPlayer;        // AI's player (PLAYER1)
     Player opponent;        // Opponent player (PLAYER2)
-    int maxDepth;           // Maximum search depth
+    int maxDepth;           // Maximum search depth of getBestMove
 
-    // Node count for performance tracking
-    mutable long long nodesEvaluated;
+    // Totals of the per-thread counters for the last search
+    long long nodesEvaluated;
+    long long betaCutoffs;
+    long long firstMoveCutoffs;
 
-    // MinMax with Alpha-Beta Pruning
-    int minmax(Board& board, int depth, bool isMaximizing, int alpha, int beta);
+    // Positions searched so far, shared by all threads and across getBestMove calls
+    TranspositionTable tt;
 
-    // Evaluation function (heuristic)
-    int evaluate(const Board& board) const;
+    // One worker per search thread (workers[0] is the main thread)
+    std::vector<std::unique_ptr<SearchWorker>> workers;
+
+    // How helper threads take part in the search
+    ParallelMode parallelMode;
+    std::atomic<bool> poolActive;   // YBWC helpers keep stealing while set
+
+    // Opening book consulted before searching (not owned, may be null)
+    const OpeningBook* book;
+
+    // Leaf evaluation and tree search in use
+    EvalMode evalMode;
+    SearchAlgorithm searchAlgorithm;
+
+    // Time budget per move in milliseconds (0 = depth limit only)
+    int timeLimitMs;
+
+    // Node budget per move, all threads (0 = none)
+    long long nodeLimit;
+
+    // Iterative deepening state
+    std::chrono::steady_clock::time_point searchStart;
+    int searchDepthLimit;           // Limits of the running search, copied from the
+    int searchTimeLimitMs;          // settings above (or the ponder limits) at its start
+    long long searchNodeLimit;
+    std::atomic<int> completedDepth;    // Last depth fully searched by the main thread
+    int lastScore;                  // Score of that iteration (AI's point of view)
+    std::atomic<bool> stopSearch;   // Set when the time budget runs out or the main thread is done
+    std::atomic<bool> stopRequested;    // Set by requestStop from another thread
+
+    // Result of the last completed iteration, for getProgress, and
+    // statistics of the last finished search (both under progressLock)
+    mutable std::mutex progressLock;
+    SearchProgress progress;
+    SearchStats lastStats;
+
+    // Each finished search appends its statistics here as a JSON line (not owned, may be null)
+    std::ostream* statsLog;
+
+    // Fill lastStats from the worker counters and iterations and log them
+    void finishStats(const IterationStats* iterations, int iterationCount, bool fromBook);
+
+    // Record a completed iteration for getProgress
+    void publishProgress(int depth, int score, const Move& bestMove);
+
+    // Pondering: a background search of the position after the opponent's
+    // predicted reply, run while the opponent thinks
+    std::thread ponderThread;
+    std::atomic<bool> ponderStop;   // Ends the background search
+    std::atomic<bool> ponderDone;   // Set when the background search has returned
+    Board ponderBoard;              // Position being pondered (AI to move)
+    Move ponderMove;                // Result of the background search
+    bool ponderHitPending;          // The opponent played the predicted reply
+    std::chrono::steady_clock::time_point ponderStartTime;
+    long long ponderHits;
+    long long ponderMisses;
+
+    // Iterative deepening search of board with the given limits
+    Move search(const Board& board, int depthLimit, int timeLimit, long long nodeBudget);
+
+    // Iterative deepening loop of a Lazy SMP helper thread
+    void helperSearch(SearchWorker& worker, const Board& board);
+
+    // YBWC helper thread: steal and run tasks until the search ends
+    void poolLoop(SearchWorker& worker);
+
+    // True if a node at this depth/ply should hand its siblings to other threads
+    bool canSplit(int depth, int ply) const;
+
+    // Publish siblings as tasks and help until all of them are finished
+    void splitSearch(SearchWorker& worker, SplitPoint& splitPoint, const MoveList& siblings);
+
+    // Search one sibling of a split point
+    void runTask(SearchWorker& worker, SplitTask& task);
+
+    // Steal a task from another thread (within splitPoint if given)
+    SplitTask* stealTask(SearchWorker& worker, const SplitPoint* splitPoint);
+
+    // True if the worker's current search must stop (time up or sibling cutoff)
+    bool aborted(const SearchWorker& worker) const {
+        return stopSearch.load(std::memory_order_relaxed) ||
+               (worker.currentSplit && worker.currentSplit->cancelled());
+    }
+
+    // One iteration of iterative deepening. NEGAMAX_PVS starts with a
+    // window around previousScore and widens it until the score falls inside.
+    // MTDF starts at parityScore, the score of the iteration two plies
+    // shallower (previousScore if there is none): scores alternate with the
+    // side to move at the horizon, so it is the closer guess.
+    // Returns false if the iteration was aborted.
+    bool searchIteration(SearchWorker& worker, MoveList& moves, int depth, int previousScore,
+                         int parityScore, Move& bestMove, int& bestScore);
+
+    // MTD(f) iteration: zero-window root searches starting at guess until
+    // the lower and upper bounds meet. The move of the last pass that failed
+    // high is searched first by the next pass and returned. Returns false
+    // if aborted.
+    bool mtdf(SearchWorker& worker, MoveList& moves, int depth, int guess, Move& bestMove, int& bestScore);
+
+    // Search all root moves to the given depth within (alpha, beta).
+    // Returns false if the iteration was aborted.
+    bool searchRoot(SearchWorker& worker, MoveList& moves, int depth, int alpha, int beta,
+                    Move& bestMove, int& bestScore);
+
+    // True once the time or node budget is spent (only after depth 1
+    // completed), when pondering is being stopped, or on requestStop
+    bool timeUp() const;
+
+    // Transposition table lookup shared by both searches. Returns true with
+    // score set if the stored bound ends the search; otherwise may narrow
+    // the window and sets hashMove.
+    bool probeTT(SearchWorker& worker, uint64_t key, int depth, int& alpha, int& beta, PackedMove& hashMove,
+                 int& score) const;
+
+    // MinMax with Alpha-Beta Pruning on worker.board
+    int minmax(SearchWorker& worker, int depth, bool isMaximizing, int alpha, int beta, int ply);
+
+    // Negamax with alpha-beta on worker.board, compiled once per side to move.
+    // Scores are from the side to move's point of view.
+    template <bool AiToMove>
+    int negamax(SearchWorker& worker, int depth, int alpha, int beta, int ply);
+
+    // Score of the position just reached, for the side that moved into it.
+    // All but the first child are scouted with a null window and re-searched
+    // only if they beat alpha (principal variation search).
+    template <bool ChildAiToMove>
+    int searchChild(SearchWorker& worker, int depth, int alpha, int beta, int ply, bool firstChild);
 
     // Mobility heuristic: count of valid moves
     int getMobility(const Board& board, Player player) const;
@@ -27,21 +308,129 @@ private:
     // Position value heuristic: prefer central positions
     int getPositionValue(const Position& pos) const;
 
+    // Territory heuristic: cells the AI reaches first minus the opponent's
+    int getTerritoryValue(const Board& board) const;
+
 public:
     // Constructor
-    AI(Player player = Player::PLAYER1, int depth = 5);
+    AI(Player player = Player::PLAYER1, int depth = 5, int hashSizeMB = DEFAULT_HASH_MB,
+       int threads = 1);
 
-    // Get the best move for the current board state
+    ~AI();
+
+    AI(const AI&) = delete;
+    AI& operator=(const AI&) = delete;
+
+    // Get the best move for the current board state.
+    // Searches depth 1, 2, ... up to the depth limit, stopping early when
+    // the time limit (if set) runs out. Always returns the best move of
+    // the last completed iteration.
+    // After a ponder hit on board, takes over the background search.
     Move getBestMove(const Board& board);
 
+    // Start pondering. board is the position right after the AI's move.
+    // The opponent's reply is predicted from the transposition table and the
+    // position after it is searched in a background thread, filling the
+    // table, up to PONDER_EXTRA_DEPTH plies past the depth limit and
+    // PONDER_TIME_FACTOR times the time budget. Returns false if there is
+    // nothing to ponder.
+    // Changing threads, hash size, parallel mode, evaluation, algorithm or
+    // book stops the background search. Depth, time and node limits do not
+    // (a ponder hit uses the ones set when getBestMove is called); like all
+    // settings they must not change while getBestMove runs in another thread.
+    bool startPonder(const Board& board);
+
+    // The opponent has moved and board is the new position. On a hit (the
+    // predicted reply) the background search keeps running and getBestMove
+    // takes it over, counting its time against the budget; on a miss it is
+    // stopped. Returns true on a hit.
+    bool resolvePonder(const Board& board);
+
+    // Abandon the background search, if any
+    void stopPonder();
+
+    bool isPondering() const { return ponderThread.joinable(); }
+
+    // Make a search running in another thread return as soon as possible
+    // with the best move of its last completed iteration. Stays in effect
+    // (later searches return at once) until clearStopRequest.
+    void requestStop() { stopRequested = true; }
+    void clearStopRequest() { stopRequested = false; }
+
+    // Depth, score, best move and node count of the running (or last)
+    // search; safe to call from any thread
+    SearchProgress getProgress() const;
+
+    // Ponder hits and misses counted by resolvePonder
+    long long getPonderHits() const { return ponderHits; }
+    long long getPonderMisses() const { return ponderMisses; }
+
     // Set search depth
     void setDepth(int depth) { maxDepth = depth; }
 
-    // Get nodes evaluated (for debugging)
+    // Set time budget per move in milliseconds (0 = no limit)
+    void setTimeLimit(int milliseconds) { timeLimitMs = milliseconds; }
+
+    // Set node budget per move, counted over all threads and checked every
+    // TIME_CHECK_INTERVAL nodes (0 = no limit). Pondering ignores it.
+    void setNodeLimit(long long nodes) { nodeLimit = nodes; }
+
+    // Depth reached by the last getBestMove call
+    int getCompletedDepth() const { return completedDepth; }
+
+    // Set number of search threads (1 = single-threaded)
+    void setThreads(int threads);
+
+    // Number of search threads
+    int getThreads() const { return static_cast<int>(workers.size()); }
+
+    // Choose how extra threads search (Lazy SMP or YBWC); no effect with 1 thread
+    void setParallelMode(ParallelMode mode);
+    ParallelMode getParallelMode() const { return parallelMode; }
+
+    // Choose the leaf evaluation
+    void setEvalMode(EvalMode mode);
+    EvalMode getEvalMode() const { return evalMode; }
+
+    // Choose the tree search; clears the transposition table because the two
+    // store scores from different points of view
+    void setSearchAlgorithm(SearchAlgorithm algorithm);
+    SearchAlgorithm getSearchAlgorithm() const { return searchAlgorithm; }
+
+    // Use moves from an opening book when the position is in it (nullptr = none).
+    // The book must outlive the AI or be reset before it is closed.
+    void setOpeningBook(const OpeningBook* openingBook);
+
+    // Static evaluation of board from the AI's point of view (the score
+    // the search gives a leaf)
+    int evaluate(const Board& board) const;
+
+    // Score of the move returned by the last getBestMove (AI's point of view)
+    int getLastScore() const { return lastScore; }
+
+    // Get nodes evaluated by all threads in the last search (for debugging)
     long long getNodesEvaluated() const { return nodesEvaluated; }
 
     // Reset node counter
     void resetNodeCounter() { nodesEvaluated = 0; }
+
+    // Statistics of the last finished search; safe to call from any thread
+    SearchStats getLastSearchStats() const;
+
+    // Append the statistics of every finished search to out as JSON lines
+    // (nullptr = off). out must outlive the AI or be reset first.
+    void setStatsLog(std::ostream* out);
+
+    // Fraction of beta cutoffs produced by the first move searched (last search)
+    double getFirstMoveCutoffRate() const {
+        return betaCutoffs ? static_cast<double>(firstMoveCutoffs) / betaCutoffs : 0.0;
+    }
+
+    // Resize the transposition table (0 disables it); clears all entries
+    void setHashSize(int megabytes);
+
+    // Forget all stored positions and move-ordering history
+    void clearHash();
 };
 
 #endif // AI_H
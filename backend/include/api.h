@@ -7,6 +7,8 @@
     #define API_EXPORT
 #endif
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -24,6 +26,23 @@ typedef struct {
     int winner;             // 1=player1, 2=player2
 } GameState;
 
+// Layout version of StateBlock; changes whenever its fields change
+#define STATE_BLOCK_LAYOUT 1
+
+// Compact game state kept up to date in memory owned by the game handle
+// (see getStateBlock). 64 bytes, no padding between fields.
+typedef struct {
+    uint32_t layout;        // STATE_BLOCK_LAYOUT
+    uint32_t version;       // Incremented whenever the state below changes
+    uint8_t cells[49];      // Row-major: 0=empty, 1=player1, 2=player2, 3=removed
+    uint8_t player1Square;  // row * 7 + col
+    uint8_t player2Square;
+    uint8_t currentPlayer;  // 1=player1, 2=player2
+    uint8_t gameOver;       // 0=not over, 1=game over
+    uint8_t winner;         // 1=player1, 2=player2, 0 while the game runs
+    uint16_t turnCount;
+} StateBlock;
+
 // Move structure for FFI
 typedef struct {
     int fromRow;
@@ -34,18 +53,132 @@ typedef struct {
     int removeCol;
 } MoveData;
 
+// Progress or result of an asynchronous AI search
+typedef struct {
+    int depth;              // Last completed iteration
+    int score;              // Its score (AI's point of view)
+    long long nodes;        // Nodes searched
+    int hasMove;            // 1 if move is set
+    MoveData move;          // Best move so far; the AI's move once finished
+} AISearchStatus;
+
+// Iterations kept in SearchStatsData (the deepest search the engine runs)
+#define SEARCH_STATS_MAX_ITERATIONS 64
+
+// One completed iteration of iterative deepening
+typedef struct {
+    int depth;
+    int score;              // AI's point of view
+    long long nodes;        // Nodes of this iteration
+    double timeMs;          // Time of this iteration
+} SearchIterationStats;
+
+// Statistics of one AI search
+typedef struct {
+    long long nodes;
+    long long leafEvals;            // Static evaluations at the horizon
+    long long betaCutoffs;
+    long long firstMoveCutoffs;     // Cutoffs by the first move searched
+    double firstMoveCutoffRate;
+    long long hashProbes;           // Transposition table lookups
+    long long hashHits;             // Lookups that found the position
+    double effectiveBranchingFactor;    // Nodes of the last iteration / the one before
+    int completedDepth;
+    int maxPly;                     // Deepest ply visited
+    double timeMs;
+    int fromBook;                   // 1 if the move came from the opening book
+    int iterationCount;
+    SearchIterationStats iterations[SEARCH_STATS_MAX_ITERATIONS];
+} SearchStatsData;
+
 // API Functions
+// A game handle owns the game and its AI engine. The engine is kept between
+// AI turns, so work from earlier searches (hash entries, move ordering)
+// speeds up later ones.
 API_EXPORT void* createGame();
 API_EXPORT void deleteGame(void* game);
 API_EXPORT void initializeGame(void* game);
 API_EXPORT void getGameState(void* game, GameState* state);
+
+// State block of the game, valid until deleteGame. It is only written by
+// calls on the game (initializeGame, makeMove), so it can be read in place
+// between calls; compare version to skip unchanged frames.
+API_EXPORT const StateBlock* getStateBlock(void* game);
 API_EXPORT int makeMove(void* game, MoveData* move);
 API_EXPORT int getAIMove(void* game, MoveData* move);
+API_EXPORT int getAIMoveTimed(void* game, int timeLimitMs, MoveData* move);
 API_EXPORT int isGameOver(void* game);
 API_EXPORT int getWinner(void* game);
 API_EXPORT int getCurrentPlayer(void* game);
 API_EXPORT int canPlayerMove(void* game, int player);
 
+// Engine settings of one game: getAIMove depth limit (default 2), getAIMove
+// time budget in ms (0 = none, default), transposition table size in MB
+// (0 disables it) and search threads. Changing the table size clears it.
+API_EXPORT void configureEngine(void* game, int depth, int timeLimitMs, int hashSizeMB, int threads);
+
+// Forget hash entries and move-ordering history of the game's engine
+API_EXPORT void clearEngineState(void* game);
+
+// Pondering: call right after the AI's move has been made. The engine
+// predicts the human's reply and searches the position after it in a
+// background thread. makeMove with the predicted reply (a hit) lets the next
+// getAIMove/getAIMoveTimed take over that search; any other move stops it.
+// Returns 1 if pondering started.
+API_EXPORT int startPonder(void* game);
+
+// Abandon pondering without making a move
+API_EXPORT void stopPonder(void* game);
+
+// Number of ponder hits and misses so far (either pointer may be null)
+API_EXPORT void getPonderStats(void* game, int* hits, int* misses);
+
+// Asynchronous AI move: the search runs in an engine thread so the caller
+// never blocks. depth <= 0 means no depth limit, timeLimitMs <= 0 no time
+// limit (run until cancelled). Returns 0 if a search is already running or
+// it is not the AI's turn. The move is not made; pass it to makeMove.
+// Other calls on the game (makeMove, getAIMove, ...) cancel the search.
+API_EXPORT int startAISearch(void* game, int depth, int timeLimitMs);
+
+// Returns 1 while the search runs (status holds its progress), 0 once it
+// has finished (status holds the result), -1 if there is no search.
+API_EXPORT int pollAISearch(void* game, AISearchStatus* status);
+
+// Stop the search; the best move found so far becomes its result
+API_EXPORT void cancelAISearch(void* game);
+
+// Statistics of the game's last finished AI search (any of getAIMove,
+// getAIMoveTimed, startAISearch or pondering). Can be called while a search
+// runs. Returns 0 if the engine has not searched yet.
+API_EXPORT int getLastSearchStats(void* game, SearchStatsData* stats);
+
+// Append the statistics of every search of the game to a file, one JSON
+// object per line. A null or empty path stops logging. Returns 1 on success.
+API_EXPORT int setSearchStatsLog(void* game, const char* path);
+
+// Transposition table size (MB) of games created afterwards; 0 disables it
+API_EXPORT void setAIHashSize(int megabytes);
+
+// Number of search threads of games created afterwards (1 = single-threaded)
+API_EXPORT void setAIThreads(int threads);
+
+// How extra threads search: 0 = Lazy SMP (default), 1 = YBWC split points
+API_EXPORT void setAIParallelMode(int mode);
+
+// Leaf evaluation: 0 = mobility (default), 1 = mobility plus territory
+API_EXPORT void setAIEvalMode(int mode);
+
+// Tree search: 0 = minmax, 1 = negamax with PVS and aspiration windows (default),
+// 2 = MTD(f)
+API_EXPORT void setAISearchAlgorithm(int algorithm);
+
+// Memory-map an opening book built by the opening_book target. The book is
+// shared by all games and loaded once: call this before starting searches.
+// Once a book is open, later calls keep it (it is never unmapped while the
+// library is loaded) and return 1.
+// Returns 1 on success, 0 if the file is missing or invalid.
+API_EXPORT int loadOpeningBook(const char* path);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,147 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include "types.h"
+#include <array>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+// A bitboard stores one bit per cell of the 7x7 board.
+// Cell (row, col) maps to square index row * BOARD_SIZE + col (0..48).
+using Bitboard = uint64_t;
+
+constexpr int NUM_SQUARES = BOARD_SIZE * BOARD_SIZE;
+constexpr int NO_SQUARE = -1;
+
+// Mask with all 49 board bits set
+constexpr Bitboard FULL_BOARD = (Bitboard(1) << NUM_SQUARES) - 1;
+
+// Square <-> position conversion
+constexpr int squareOf(int row, int col) {
+    return row * BOARD_SIZE + col;
+}
+
+inline int squareOf(const Position& pos) {
+    return squareOf(pos.row, pos.col);
+}
+
+inline Position positionOf(int square) {
+    return Position(square / BOARD_SIZE, square % BOARD_SIZE);
+}
+
+constexpr Bitboard squareBit(int square) {
+    return Bitboard(1) << square;
+}
+
+namespace detail {
+
+// Build the 8-neighbor mask of every square at compile time
+constexpr std::array<Bitboard, NUM_SQUARES> makeNeighborMasks() {
+    std::array<Bitboard, NUM_SQUARES> masks{};
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            Bitboard mask = 0;
+            for (int dRow = -1; dRow <= 1; dRow++) {
+                for (int dCol = -1; dCol <= 1; dCol++) {
+                    int r = row + dRow;
+                    int c = col + dCol;
+                    if ((dRow != 0 || dCol != 0) &&
+                        r >= MIN_COORD && r <= MAX_COORD &&
+                        c >= MIN_COORD && c <= MAX_COORD) {
+                        mask |= squareBit(squareOf(r, c));
+                    }
+                }
+            }
+            masks[squareOf(row, col)] = mask;
+        }
+    }
+    return masks;
+}
+
+} // namespace detail
+
+// NEIGHBOR_MASKS[sq] has a bit set for each of the (up to 8) adjacent squares
+constexpr std::array<Bitboard, NUM_SQUARES> NEIGHBOR_MASKS = detail::makeNeighborMasks();
+
+namespace detail {
+
+constexpr Bitboard makeColumnMask(int col) {
+    Bitboard mask = 0;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        mask |= squareBit(squareOf(row, col));
+    }
+    return mask;
+}
+
+} // namespace detail
+
+// Cells of the first and last column (shifts along a row must not wrap)
+constexpr Bitboard FIRST_COLUMN = detail::makeColumnMask(MIN_COORD);
+constexpr Bitboard LAST_COLUMN = detail::makeColumnMask(MAX_COORD);
+
+// Cells of b plus all their 8-neighbors
+constexpr Bitboard dilate(Bitboard b) {
+    Bitboard row = b | ((b & ~LAST_COLUMN) << 1) | ((b & ~FIRST_COLUMN) >> 1);
+    return (row | (row << BOARD_SIZE) | (row >> BOARD_SIZE)) & FULL_BOARD;
+}
+
+// Left-right mirror image of a square. The board and both start squares
+// are symmetric about the middle column.
+constexpr int mirrorSquare(int square) {
+    return square + MAX_COORD - 2 * (square % BOARD_SIZE);
+}
+
+// Left-right mirror image of a bitboard (one shift per column)
+constexpr Bitboard mirror(Bitboard b) {
+    Bitboard result = 0;
+    for (int col = MIN_COORD; col <= MAX_COORD; col++) {
+        Bitboard column = b & (FIRST_COLUMN << col);
+        int shift = MAX_COORD - 2 * col;
+        result |= (shift >= 0) ? (column << shift) : (column >> -shift);
+    }
+    return result;
+}
+
+// All cells of passable connected to seed (8-neighborhood), seed included
+constexpr Bitboard floodFill(Bitboard seed, Bitboard passable) {
+    Bitboard region = seed;
+    while (true) {
+        Bitboard grown = region | (dilate(region) & passable);
+        if (grown == region) {
+            return region;
+        }
+        region = grown;
+    }
+}
+
+// Number of set bits
+inline int popCount(Bitboard b) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(b));
+#else
+    return __builtin_popcountll(b);
+#endif
+}
+
+// Index of the least significant set bit (b must be non-zero)
+inline int lsb(Bitboard b) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, b);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(b);
+#endif
+}
+
+// Remove and return the least significant set bit (b must be non-zero)
+inline int popLsb(Bitboard& b) {
+    int square = lsb(b);
+    b &= b - 1;
+    return square;
+}
+
+#endif // BITBOARD_H
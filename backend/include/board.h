@@ -2,17 +2,52 @@
 #define BOARD_H
 
 #include "types.h"
+#include "bitboard.h"
+#include "movelist.h"
+#include "zobrist.h"
 #include <vector>
 #include <array>
 
+// Cells each player reaches strictly before the other (see Board::getTerritory)
+struct Territory {
+    int player1;
+    int player2;
+};
+
+// Compact record needed to take back a move made with Board::makeMove
+struct UndoInfo {
+    int8_t fromSq;      // Square the piece moved from
+    int8_t removedSq;   // Square that was removed
+};
+
 class Board {
 private:
-    // 7x7 grid to store cell states
-    std::array<std::array<CellState, BOARD_SIZE>, BOARD_SIZE> grid;
+    // Removed cells (never walkable again)
+    Bitboard removedMask;
+
+    // Empty cells a piece may step on (not removed, not occupied)
+    Bitboard walkableMask;
+
+    // Current squares of players (row * BOARD_SIZE + col)
+    int player1Sq;
+    int player2Sq;
+
+    // Zobrist key, updated incrementally by every move
+    uint64_t hashKey;
+
+    // Key of the left-right mirror image, updated alongside hashKey
+    uint64_t mirrorKey;
+
+    // Rebuild walkableMask from removedMask and player squares
+    void updateWalkable() {
+        walkableMask = FULL_BOARD & ~removedMask & ~squareBit(player1Sq) & ~squareBit(player2Sq);
+    }
 
-    // Current positions of players
-    Position player1Pos;
-    Position player2Pos;
+    // Zobrist key of piece squares and removed cells (side to move excluded)
+    uint64_t computePositionKey() const;
+
+    // Same for the mirror image of the position
+    uint64_t computeMirroredKey() const;
 
 public:
     // Constructor
@@ -29,6 +64,11 @@ public:
     void setCellState(const Position& pos, CellState state);
     void setCellState(int row, int col, CellState state);
 
+    // Set the side to move in the hash keys. Boards only track it through
+    // the moves made, so call this after setting up a position cell by cell
+    // for the second player to move.
+    void setSideToMove(Player player);
+
     // Get player positions
     Position getPlayerPosition(Player player) const;
 
@@ -47,10 +87,28 @@ public:
     // Apply a move to the board (returns true if successful)
     bool applyMove(const Move& move, Player player);
 
+    // Apply a move known to be legal (no validation) and record how to undo it.
+    // Used by the search to mutate one board in place instead of copying.
+    void makeMove(const Move& move, Player player, UndoInfo& undo);
+
+    // Take back a move made with makeMove
+    void unmakeMove(Player player, const UndoInfo& undo);
+
     // Get all possible moves for a player
     std::vector<Move> getAllPossibleMoves(Player player) const;
 
-    // Check if a player can make any moves
+    // Fill a stack-allocated move list (allocation-free)
+    void generateMoves(Player player, MoveList& moves) const;
+
+    // Call visit(move) for each legal move, in the same order as
+    // getAllPossibleMoves. The visitor returns false to stop early.
+    // The visitor may make/unmake moves on this board as long as the
+    // board is restored before it returns.
+    // Returns false if generation was stopped by the visitor.
+    template <typename Visitor>
+    bool forEachMove(Player player, Visitor&& visit) const;
+
+    // Check if a player can make any moves (one mask test, no move generation)
     bool canPlayerMove(Player player) const;
 
     // Copy board state
@@ -59,10 +117,120 @@ public:
     // Display board (for debugging/CLI)
     void display() const;
 
-    // Get grid (for direct access if needed)
-    const std::array<std::array<CellState, BOARD_SIZE>, BOARD_SIZE>& getGrid() const {
-        return grid;
+    // Get grid (built from the bitboards, for display/export)
+    std::array<std::array<CellState, BOARD_SIZE>, BOARD_SIZE> getGrid() const;
+
+    // Bitboard access for the search hot path
+    Bitboard getRemovedMask() const { return removedMask; }
+    Bitboard getWalkableMask() const { return walkableMask; }
+
+    int getPlayerSquare(Player player) const {
+        return (player == Player::PLAYER1) ? player1Sq : player2Sq;
+    }
+
+    // Squares the player's piece can step to
+    Bitboard getMoveTargets(Player player) const {
+        return NEIGHBOR_MASKS[getPlayerSquare(player)] & walkableMask;
+    }
+
+    // Zobrist key of the position (pieces, removed cells, side to move)
+    uint64_t getHash() const { return hashKey; }
+
+    // Zobrist key of the left-right mirror image of the position
+    uint64_t getMirroredHash() const { return mirrorKey; }
+
+    // Key shared by the position and its mirror image. Tables keyed by it
+    // (transposition table, opening book) store each position once.
+    uint64_t getCanonicalHash() const { return (mirrorKey < hashKey) ? mirrorKey : hashKey; }
+
+    // True if the canonical key is the mirror image's: moves stored under
+    // the canonical key are mirrored relative to this board
+    bool isMirrored() const { return mirrorKey < hashKey; }
+
+    // Convert a packed move between this board's orientation and the
+    // canonical one (mirroring is its own inverse)
+    PackedMove orientMove(PackedMove move) const {
+        return isMirrored() ? mirrorMove(move) : move;
+    }
+
+    // True if the position equals its mirror image; every move then has
+    // a mirrored twin with the same value
+    bool isSymmetric() const {
+        return mirrorSquare(player1Sq) == player1Sq && mirrorSquare(player2Sq) == player2Sq &&
+               mirror(removedMask) == removedMask;
+    }
+
+    // Number of squares the player's piece can step to.
+    // walkableMask is kept current by every move, so this is one AND and a
+    // popcount; no separate counters need updating on make/unmake.
+    int getMobility(Player player) const {
+        return popCount(getMoveTargets(player));
+    }
+
+    // Mobility the player would have after stepping to toSq (before the removal)
+    int getMobilityAfterStep(Player player, int toSq) const {
+        Bitboard walkableAfter = walkableMask | squareBit(getPlayerSquare(player));
+        return popCount(NEIGHBOR_MASKS[toSq] & walkableAfter);
+    }
+
+    // Voronoi split of the walkable cells: both pieces expand one ring per
+    // step at the same time; cells reached by both in the same step are shared
+    Territory getTerritory() const;
+
+    // Cells the player may remove after stepping to toSq
+    Bitboard getRemovableMask(Player player, int toSq) const {
+        Player opponent = (player == Player::PLAYER1) ? Player::PLAYER2 : Player::PLAYER1;
+        return FULL_BOARD & ~removedMask & ~squareBit(toSq) & ~squareBit(getPlayerSquare(opponent));
     }
 };
 
+inline Territory Board::getTerritory() const {
+    Bitboard front1 = squareBit(player1Sq);
+    Bitboard front2 = squareBit(player2Sq);
+    Bitboard unclaimed = walkableMask;
+    Bitboard owned1 = 0;
+    Bitboard owned2 = 0;
+
+    // Whole rings are expanded with shifts, so each step costs a few
+    // instructions no matter how many cells the fronts hold
+    while (front1 | front2) {
+        Bitboard next1 = dilate(front1) & unclaimed;
+        Bitboard next2 = dilate(front2) & unclaimed;
+        Bitboard shared = next1 & next2;
+        owned1 |= next1 & ~shared;
+        owned2 |= next2 & ~shared;
+        unclaimed &= ~(next1 | next2);
+        front1 = next1;
+        front2 = next2;
+    }
+
+    return Territory{popCount(owned1), popCount(owned2)};
+}
+
+template <typename Visitor>
+bool Board::forEachMove(Player player, Visitor&& visit) const {
+    int opponentSq = (player == Player::PLAYER1) ? player2Sq : player1Sq;
+    Position currentPos = positionOf(getPlayerSquare(player));
+
+    // Any cell that is not removed and not under the opponent may be removed
+    Bitboard removableBase = FULL_BOARD & ~removedMask & ~squareBit(opponentSq);
+
+    // For each valid neighbor position
+    Bitboard targets = getMoveTargets(player);
+    while (targets) {
+        int toSq = popLsb(targets);
+        Position toPos = positionOf(toSq);
+
+        // Every removable cell except the target position
+        Bitboard removable = removableBase & ~squareBit(toSq);
+        while (removable) {
+            if (!visit(Move(currentPos, toPos, positionOf(popLsb(removable))))) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 #endif // BOARD_H
@@ -0,0 +1,70 @@
+#ifndef BOOK_H
+#define BOOK_H
+
+#include "movelist.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Opening book file: a 16-byte header followed by BookEntry records sorted
+// by key. Built offline by tools/book_gen.cpp (CMake target opening_book),
+// memory-mapped at runtime and searched in place.
+
+// One book position: canonical Zobrist key (Board::getCanonicalHash), best
+// move for the side to move in canonical orientation, and its score
+struct BookEntry {
+    uint64_t key;
+    PackedMove move;
+    uint16_t reserved;
+    int32_t score;
+};
+
+static_assert(sizeof(BookEntry) == 16, "book entries are stored as 16-byte records");
+
+struct BookHeader {
+    char magic[8];      // "SGBOOK\0\0"
+    uint32_t version;
+    uint32_t count;     // Number of entries after the header
+};
+
+static_assert(sizeof(BookHeader) == 16, "book header is 16 bytes");
+
+constexpr uint32_t BOOK_VERSION = 2;
+
+// Sort entries by key and write them as a book file; returns false on I/O error
+bool writeOpeningBook(const char* path, std::vector<BookEntry> entries);
+
+// Read-only view of a book file mapped into memory
+class OpeningBook {
+private:
+    const BookEntry* entries;
+    size_t count;
+
+    // Mapping state (file and mapping handles are only used on Windows)
+    const void* view;
+    size_t viewSize;
+    void* fileHandle;
+    void* mappingHandle;
+
+public:
+    OpeningBook();
+    ~OpeningBook();
+
+    OpeningBook(const OpeningBook&) = delete;
+    OpeningBook& operator=(const OpeningBook&) = delete;
+
+    // Map a book file, replacing any open book; returns false if the file
+    // is missing or not a valid book
+    bool open(const char* path);
+
+    // Unmap the book
+    void close();
+
+    bool isOpen() const { return entries != nullptr; }
+    size_t size() const { return count; }
+
+    // Binary search for a position; returns true and fills entry on a hit
+    bool probe(uint64_t key, BookEntry& entry) const;
+};
+
+#endif // BOOK_H
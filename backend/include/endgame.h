@@ -0,0 +1,67 @@
+#ifndef ENDGAME_H
+#define ENDGAME_H
+
+#include "board.h"
+#include <cstdint>
+#include <memory>
+
+// Exact solver for separated positions.
+// Once removed cells wall the two pieces off from each other, each side
+// only walks inside its own area and the game is a race: who runs out of
+// steps first. Removing a cell of the opponent's area is never worse than
+// removing any other cell, so the solver only tries those (or, if there
+// are none, a cell neither side can reach, or else one of its own).
+
+// Largest combined size of both areas (pieces included) solved exactly
+constexpr int ENDGAME_MAX_CELLS = 16;
+
+// Fewest removed cells with which probe looks for a separation. Walls
+// rarely close earlier (none in random playouts before 16 removals), and
+// the flood fill is not worth paying at every node of the middle game.
+constexpr int ENDGAME_MIN_REMOVED = 16;
+
+// Memo entries per solver (power of two)
+constexpr int ENDGAME_TABLE_SIZE = 1 << 16;
+
+// Areas each piece can still reach, pieces' squares included
+struct Separation {
+    Bitboard area1;
+    Bitboard area2;
+};
+
+// Flood fill from both pieces over walkable cells. Returns true if the
+// areas can never touch again (no cell of one is adjacent to the other).
+bool findSeparation(const Board& board, Separation& separation);
+
+class EndgameSolver {
+private:
+    // Side to move's area and square, neutral cell count (first word);
+    // opponent's area and square, result and used flag (second word)
+    struct Entry {
+        uint64_t mover;
+        uint64_t other;
+    };
+
+    std::unique_ptr<Entry[]> table;
+
+    // True if the side to move wins. Areas exclude the pieces' squares;
+    // neutral counts walkable cells neither side can reach.
+    bool solve(Bitboard myArea, int mySq, Bitboard oppArea, int oppSq, int neutral);
+
+public:
+    EndgameSolver();
+
+    EndgameSolver(const EndgameSolver&) = delete;
+    EndgameSolver& operator=(const EndgameSolver&) = delete;
+
+    // Solve a separated position with small areas.
+    // Returns false if the position is not handled (including any with
+    // fewer than ENDGAME_MIN_REMOVED removed cells); otherwise sets
+    // toMoveWins to the exact game result for toMove.
+    bool probe(const Board& board, Player toMove, bool& toMoveWins);
+
+    // Forget all memoized results
+    void clear();
+};
+
+#endif // ENDGAME_H
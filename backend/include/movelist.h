@@ -0,0 +1,72 @@
+#ifndef MOVELIST_H
+#define MOVELIST_H
+
+#include "types.h"
+#include "bitboard.h"
+#include <cstdint>
+#include <new>
+
+// Upper bound on legal moves in any position:
+// 8 destinations x (49 cells - destination - opponent's cell) removals
+constexpr int MAX_MOVES = 8 * (NUM_SQUARES - 2);
+
+// Fixed-capacity move container that lives on the stack.
+// Used by move generation and search so that no node touches the heap.
+// Storage is left uninitialized; only the first size() slots are valid.
+class MoveList {
+private:
+    alignas(Move) unsigned char storage[MAX_MOVES * sizeof(Move)];
+    int count;
+
+    Move* data() { return reinterpret_cast<Move*>(storage); }
+    const Move* data() const { return reinterpret_cast<const Move*>(storage); }
+
+public:
+    MoveList() : count(0) {}
+
+    MoveList(const MoveList&) = delete;
+    MoveList& operator=(const MoveList&) = delete;
+
+    void push_back(const Move& move) { new (data() + count++) Move(move); }
+    void clear() { count = 0; }
+
+    // Drop all moves after the first newSize
+    void truncate(int newSize) { count = newSize; }
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    Move& operator[](int index) { return data()[index]; }
+    const Move& operator[](int index) const { return data()[index]; }
+
+    Move* begin() { return data(); }
+    Move* end() { return data() + count; }
+    const Move* begin() const { return data(); }
+    const Move* end() const { return data() + count; }
+};
+
+// 16-bit move encoding for search tables:
+// destination square in bits 0-5, removed square in bits 6-11.
+// The origin square is implied by the position the move belongs to.
+using PackedMove = uint16_t;
+
+// Never a legal move (destination and removed cell cannot both be square 0)
+constexpr PackedMove NO_MOVE = 0;
+
+inline PackedMove packMove(const Move& move) {
+    return static_cast<PackedMove>(squareOf(move.to) | (squareOf(move.removeCell) << 6));
+}
+
+inline Move unpackMove(PackedMove packed, const Position& from) {
+    return Move(from, positionOf(packed & 63), positionOf((packed >> 6) & 63));
+}
+
+// The same move on the left-right mirrored board
+inline PackedMove mirrorMove(PackedMove packed) {
+    if (packed == NO_MOVE) {
+        return NO_MOVE;
+    }
+    return static_cast<PackedMove>(mirrorSquare(packed & 63) | (mirrorSquare((packed >> 6) & 63) << 6));
+}
+
+#endif // MOVELIST_H
@@ -0,0 +1,104 @@
+#ifndef MOVEPICK_H
+#define MOVEPICK_H
+
+#include "board.h"
+#include "movelist.h"
+#include "types.h"
+
+// Deepest ply the ordering tables track
+constexpr int MAX_PLY = 64;
+
+// Killer moves remembered per ply
+constexpr int NUM_KILLERS = 2;
+
+// History scores are halved once any entry exceeds this
+constexpr int HISTORY_MAX = 1 << 16;
+
+// Search state that learns which moves cause cutoffs
+struct OrderingTables {
+    // Quiet moves that caused a beta cutoff at each ply
+    PackedMove killers[MAX_PLY][NUM_KILLERS];
+
+    // Cutoff counters indexed by [player][to square][removed square]
+    int history[2][NUM_SQUARES][NUM_SQUARES];
+
+    OrderingTables() { clear(); }
+
+    // Forget everything
+    void clear();
+
+    // Start a new search: drop killers, halve history
+    void newSearch();
+
+    // Record a move that caused a beta cutoff
+    void recordCutoff(Player player, PackedMove move, int ply, int depth);
+};
+
+// Returns the moves of a position in search order, generating them in
+// stages so that a cutoff early on never pays for the remaining moves:
+// 1. the hash move (if legal)
+// 2. killer moves for this ply (if legal)
+// 3. destinations, ordered by the mobility they leave the mover
+// 4. per destination, removals next to the opponent, best history first
+// 5. per destination, all other removals, best history first
+// Removals are only generated when their destination is reached.
+class MovePicker {
+private:
+    enum class Stage {
+        HASH_MOVE,
+        KILLERS,
+        DESTINATIONS,
+        ADJACENT_REMOVALS,
+        OTHER_REMOVALS,
+        DONE
+    };
+
+    const Board& board;
+    Player player;
+    Position from;
+    const OrderingTables& tables;
+    int ply;
+    Stage stage;
+
+    // Moves already returned by the hash/killer stages
+    PackedMove searched[1 + NUM_KILLERS];
+    int searchedCount;
+    int killerIndex;
+
+    // Destination squares in search order
+    int destinations[8];
+    int destinationCount;
+    int destinationIndex;
+
+    // Removal candidates for the current destination and stage
+    int removals[NUM_SQUARES];
+    int removalScores[NUM_SQUARES];
+    int removalCount;
+    int removalIndex;
+
+    // Cells next to the opponent's piece
+    Bitboard nearOpponent;
+
+    bool alreadySearched(PackedMove move) const;
+
+    // Order destinations by resulting mobility
+    void orderDestinations();
+
+    // Fill the removal buffer for the current destination
+    void loadRemovals(Bitboard mask);
+
+    // Next removal of the current stage across all destinations
+    bool nextRemoval(Move& move, bool adjacent);
+
+public:
+    MovePicker(const Board& board, Player player, PackedMove hashMove,
+               const OrderingTables& tables, int ply);
+
+    MovePicker(const MovePicker&) = delete;
+    MovePicker& operator=(const MovePicker&) = delete;
+
+    // Get the next move; returns false when all moves were returned
+    bool next(Move& move);
+};
+
+#endif // MOVEPICK_H
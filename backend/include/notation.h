@@ -0,0 +1,30 @@
+#ifndef NOTATION_H
+#define NOTATION_H
+
+#include "board.h"
+#include "types.h"
+#include <string>
+
+// Text forms used by tools and the engine protocol.
+// A cell is its row letter and column number as in the interactive game
+// ("b4": row b of a-g, column 4 of 1-7). A move is its from, to and
+// removed cells ("a4b4c5"). A position lists the 49 cells row by row with
+// '/' between rows: '.' empty, 'x' removed, '1' and '2' the pieces.
+
+std::string cellToString(const Position& pos);
+
+// Parse the two characters of a cell at text[offset]; returns false if invalid
+bool parseCell(const std::string& text, size_t offset, Position& pos);
+
+std::string moveToString(const Move& move);
+
+// Parse a move; returns false if malformed (legality is not checked)
+bool parseMove(const std::string& text, Move& move);
+
+std::string positionToString(const Board& board);
+
+// Set board to a position string ('/' optional); returns false and leaves
+// board unchanged if malformed
+bool parsePosition(const std::string& text, Board& board);
+
+#endif // NOTATION_H
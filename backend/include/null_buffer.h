@@ -0,0 +1,16 @@
+#ifndef NULL_BUFFER_H
+#define NULL_BUFFER_H
+
+#include <streambuf>
+
+// Stream buffer that discards everything written to it. Tools install it
+// as std::cout's buffer to silence the search's console log (debug builds
+// only; release builds compile the log out). It has no put area and no
+// state of its own: overflow and xsputn just report success.
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return traits_type::not_eof(c); }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+#endif // NULL_BUFFER_H
@@ -0,0 +1,34 @@
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+
+#include <istream>
+#include <ostream>
+
+// Line-based engine protocol in the style of UCI, for analysis GUIs, test
+// harnesses and scripts that keep the engine running as one process.
+// Cells, moves and positions use the notation of notation.h.
+//
+// Commands (one per line):
+//   uci                         identify, list options, answer "uciok"
+//   isready                     answer "readyok"
+//   ucinewgame                  forget hash entries and move ordering
+//   position startpos [moves <m>...]
+//   position cells <position> <side> [moves <m>...]    side to move 1 or 2
+//   go [depth N] [movetime MS] [nodes N] [infinite]
+//   stop                        end the search; it still answers bestmove
+//   setoption name <Name> value <Value>
+//   d                           show the position
+//   quit
+//
+// Output: "info depth D score cp S nodes N time MS nps X pv <move>" after
+// each completed iteration, then "bestmove <move>" ("bestmove none" if the
+// side to move is stuck). Scores are from the side to move's point of view;
+// a settled result is "score mate N", N of its own moves away (negative when
+// it loses). Searches run in their own thread; other commands are read
+// meanwhile. End of input stops a running search, like quit.
+
+// Run the protocol until "quit" or the end of input. Replies go to out;
+// the search's own console log is discarded meanwhile. Returns 0.
+int runProtocol(std::istream& in, std::ostream& out);
+
+#endif // PROTOCOL_H
@@ -0,0 +1,74 @@
+#ifndef TT_H
+#define TT_H
+
+#include "movelist.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Kind of score stored in a transposition table entry
+enum class Bound : uint8_t {
+    NONE,
+    UPPER,      // Search failed low: true score <= stored score
+    LOWER,      // Search failed high: true score >= stored score
+    EXACT       // Score inside the search window
+};
+
+// Decoded table entry returned by probe
+struct TTEntry {
+    uint64_t key;           // Full Zobrist key of the position
+    int32_t score;          // Search score (win scores stored relative to the node)
+    PackedMove move;        // Best move found, NO_MOVE if none
+    int8_t depth;           // Remaining depth the score was searched to
+    uint8_t genBound;       // Search generation (bits 2-7) and Bound (bits 0-1)
+
+    Bound bound() const { return static_cast<Bound>(genBound & 3); }
+    uint8_t generation() const { return genBound >> 2; }
+};
+
+// Four entries share one 64-byte cache line
+constexpr int TT_BUCKET_SIZE = 4;
+
+// Each entry is two 64-bit words: the packed data and key ^ data.
+// Threads read and write the words without locks; an entry torn by a
+// concurrent write fails the key check and is treated as a miss.
+struct alignas(64) TTBucket {
+    std::atomic<uint64_t> keyXorData[TT_BUCKET_SIZE];
+    std::atomic<uint64_t> data[TT_BUCKET_SIZE];
+};
+
+// Fixed-size, cache-line-bucketed transposition table.
+// A position maps to one bucket; probing touches a single cache line.
+// probe and store are safe to call from several search threads at once.
+class TranspositionTable {
+private:
+    std::unique_ptr<TTBucket[]> buckets;
+    uint64_t bucketCount;
+    uint64_t indexMask;     // Bucket count - 1 (count is a power of two)
+    uint8_t generation;     // Incremented per search to age old entries
+
+public:
+    // Constructor (sizeMB = 0 disables the table)
+    explicit TranspositionTable(int sizeMB = 16);
+
+    // Reallocate to the largest power-of-two bucket count fitting in sizeMB
+    void resize(int sizeMB);
+
+    // Erase all entries
+    void clear();
+
+    // Start a new search (entries from older searches are replaced first)
+    void newSearch() { generation = (generation + 1) & 63; }
+
+    // Look up a position; returns true and fills entry on a hit
+    bool probe(uint64_t key, TTEntry& entry) const;
+
+    // Store a search result for a position. A deeper entry for the same
+    // position from the current search is kept unless the new bound is EXACT.
+    void store(uint64_t key, int score, Bound bound, int depth, PackedMove move);
+
+    // Table size in megabytes
+    int getSizeMB() const;
+};
+
+#endif // TT_H
@@ -0,0 +1,103 @@
+#ifndef YBWC_H
+#define YBWC_H
+
+#include "board.h"
+#include "movelist.h"
+#include "types.h"
+#include <atomic>
+#include <mutex>
+
+// Young Brothers Wait split-point search.
+// After the first child of a node is searched serially, its remaining
+// siblings become tasks in the owner's work deque. Idle threads steal
+// them. A beta cutoff marks the split point cancelled so that running
+// and queued siblings stop early.
+//
+// The work deque is a fixed-capacity array behind a per-thread mutex, not
+// a lock-free (Chase-Lev) deque. Thieves only take tasks inside a given
+// split point, which means following a queued task's split point chain.
+// Without the lock, a task stolen and finished by another thread could
+// free that chain mid-check. Splits happen only near the root
+// (YBWC_MAX_SPLIT_PLY), so each task is a whole subtree and the lock is
+// taken rarely compared to the work it guards.
+
+// Tasks one work deque holds. Split points nest at most
+// YBWC_MAX_SPLIT_PLY + 1 deep on a thread (one per ply from the root),
+// each with fewer than MAX_MOVES siblings; push reports failure beyond this.
+constexpr int WORK_DEQUE_CAPACITY = 4 * MAX_MOVES;
+
+// Shared state of a node whose children are searched in parallel
+struct SplitPoint {
+    Board board;                // Position at the split node
+    Player player;              // Side to move at the split node
+    int depth;                  // Remaining depth at the split node
+    int ply;                    // Distance from the root
+    bool isMaximizing;          // AI to move at the split node
+    SplitPoint* parent;         // Enclosing split point, if this node is inside a task
+
+    std::mutex lock;            // Guards bestEval, bestMove, alpha and beta updates
+    int bestEval;
+    PackedMove bestMove;
+    std::atomic<int> alpha;     // Window shared by all siblings
+    std::atomic<int> beta;
+    std::atomic<bool> cutoff;   // Set on a beta cutoff; siblings abort
+    std::atomic<int> pending;   // Tasks not yet finished
+
+    SplitPoint(const Board& board, Player player, int depth, int ply, bool isMaximizing,
+               SplitPoint* parent, int alpha, int beta, int bestEval, PackedMove bestMove)
+        : board(board), player(player), depth(depth), ply(ply), isMaximizing(isMaximizing),
+          parent(parent), bestEval(bestEval), bestMove(bestMove),
+          alpha(alpha), beta(beta), cutoff(false), pending(0) {}
+
+    SplitPoint(const SplitPoint&) = delete;
+    SplitPoint& operator=(const SplitPoint&) = delete;
+
+    // True if this split point or any enclosing one was cut off
+    bool cancelled() const {
+        for (const SplitPoint* sp = this; sp; sp = sp->parent) {
+            if (sp->cutoff.load(std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // True if this split point is other or lies inside it
+    bool isWithin(const SplitPoint* other) const {
+        for (const SplitPoint* sp = this; sp; sp = sp->parent) {
+            if (sp == other) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// One sibling move to search at a split point
+struct SplitTask {
+    SplitPoint* splitPoint;
+    Move move;
+};
+
+// Per-thread work deque. The owner pushes and pops at the back (LIFO,
+// so nested split points are finished first); thieves take from the front.
+// Never allocates.
+class WorkDeque {
+private:
+    std::mutex lock;
+    SplitTask* tasks[WORK_DEQUE_CAPACITY];
+    int front = 0;      // Oldest task
+    int back = 0;       // One past the newest task
+
+public:
+    // Owner: add a task; returns false if the deque is full
+    bool push(SplitTask* task);
+
+    // Owner: take the newest task if it belongs to splitPoint (or lies inside it)
+    SplitTask* popWithin(const SplitPoint* splitPoint);
+
+    // Thief: take the oldest task; with splitPoint set, only one inside it
+    SplitTask* steal(const SplitPoint* splitPoint = nullptr);
+};
+
+#endif // YBWC_H
@@ -0,0 +1,59 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include "bitboard.h"
+#include <array>
+#include <cstdint>
+
+// Zobrist keys for incremental 64-bit position hashing.
+// A position key is the XOR of the keys of both player squares, every
+// removed cell, and ZOBRIST_SIDE when the second player is to move.
+// Boards also keep the key of their left-right mirror image so that a
+// position and its mirror share one canonical key (the smaller of the two).
+
+namespace detail {
+
+// SplitMix64 step, usable at compile time
+constexpr uint64_t splitMix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+constexpr std::array<uint64_t, NUM_SQUARES> makeZobristKeys(uint64_t seed) {
+    std::array<uint64_t, NUM_SQUARES> keys{};
+    for (int sq = 0; sq < NUM_SQUARES; sq++) {
+        keys[sq] = splitMix64(seed);
+    }
+    return keys;
+}
+
+// keys[mirrorSquare(sq)] for every square
+constexpr std::array<uint64_t, NUM_SQUARES> mirrorKeys(const std::array<uint64_t, NUM_SQUARES>& keys) {
+    std::array<uint64_t, NUM_SQUARES> mirrored{};
+    for (int sq = 0; sq < NUM_SQUARES; sq++) {
+        mirrored[sq] = keys[mirrorSquare(sq)];
+    }
+    return mirrored;
+}
+
+} // namespace detail
+
+// Keys for each player's piece standing on a square
+constexpr std::array<uint64_t, NUM_SQUARES> ZOBRIST_PLAYER1 = detail::makeZobristKeys(0x5EED0001ULL);
+constexpr std::array<uint64_t, NUM_SQUARES> ZOBRIST_PLAYER2 = detail::makeZobristKeys(0x5EED0002ULL);
+
+// Keys for removed cells
+constexpr std::array<uint64_t, NUM_SQUARES> ZOBRIST_REMOVED = detail::makeZobristKeys(0x5EED0003ULL);
+
+// The same keys indexed by mirrored square: XORing these gives the key the
+// mirror image of the position would have
+constexpr std::array<uint64_t, NUM_SQUARES> ZOBRIST_PLAYER1_MIRRORED = detail::mirrorKeys(ZOBRIST_PLAYER1);
+constexpr std::array<uint64_t, NUM_SQUARES> ZOBRIST_PLAYER2_MIRRORED = detail::mirrorKeys(ZOBRIST_PLAYER2);
+constexpr std::array<uint64_t, NUM_SQUARES> ZOBRIST_REMOVED_MIRRORED = detail::mirrorKeys(ZOBRIST_REMOVED);
+
+// Toggled on every move (side to move)
+constexpr uint64_t ZOBRIST_SIDE = 0xA5D3C1E7B92F4086ULL;
+
+#endif // ZOBRIST_H
@@ -1,37 +1,494 @@
 #include "../include/ai.h"
 #include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <thread>
 
-AI::AI(Player player, int depth)
-    : aiPlayer(player), maxDepth(depth), nodesEvaluated(0) {
+// Console log of each search, for debugging. Release builds (NDEBUG)
+// compile it out; use getLastSearchStats or setStatsLog there.
+#ifdef NDEBUG
+#define SEARCH_LOG(message) do { } while (false)
+#else
+#define SEARCH_LOG(message) do { std::cout << message << '\n'; } while (false)
+#endif
+
+namespace {
+
+// Win/loss scores depend on the remaining depth where the game ended.
+// Store them relative to the current node so they stay valid when the
+// same position is reached at a different depth.
+int scoreToTT(int score, int depth) {
+    if (score >= WIN_SCORE - MAX_SEARCH_DEPTH) return score - depth;
+    if (score <= -WIN_SCORE + MAX_SEARCH_DEPTH) return score + depth;
+    return score;
+}
+
+int scoreFromTT(int score, int depth) {
+    if (score >= WIN_SCORE - MAX_SEARCH_DEPTH) return score + depth;
+    if (score <= -WIN_SCORE + MAX_SEARCH_DEPTH) return score - depth;
+    return score;
+}
+
+// In a position equal to its mirror image every move has a mirrored twin
+// leading to the mirrored position, with the same value; keep one of each pair
+void removeMirroredMoves(const Board& board, MoveList& moves) {
+    if (!board.isSymmetric()) {
+        return;
+    }
+    int kept = 0;
+    for (const Move& move : moves) {
+        PackedMove packed = packMove(move);
+        if (packed <= mirrorMove(packed)) {
+            moves[kept++] = move;
+        }
+    }
+    moves.truncate(kept);
+}
+
+} // namespace
+
+AI::AI(Player player, int depth, int hashSizeMB, int threads)
+    : aiPlayer(player), maxDepth(depth), nodesEvaluated(0),
+      betaCutoffs(0), firstMoveCutoffs(0), tt(hashSizeMB),
+      parallelMode(ParallelMode::LAZY_SMP), poolActive(false), book(nullptr), evalMode(EvalMode::MOBILITY),
+      searchAlgorithm(SearchAlgorithm::NEGAMAX_PVS), timeLimitMs(0), nodeLimit(0), searchDepthLimit(0),
+      searchTimeLimitMs(0), searchNodeLimit(0), completedDepth(0), lastScore(0), stopSearch(false), stopRequested(false),
+      progress{0, 0, Move(), 0}, lastStats(), statsLog(nullptr), ponderStop(false),
+      ponderDone(false), ponderHitPending(false), ponderHits(0), ponderMisses(0) {
     opponent = (player == Player::PLAYER1) ? Player::PLAYER2 : Player::PLAYER1;
+    setThreads(threads);
+}
+
+AI::~AI() {
+    stopPonder();
+}
+
+void AI::setThreads(int threads) {
+    stopPonder();
+    threads = std::max(1, std::min(threads, MAX_THREADS));
+    workers.clear();
+    for (int i = 0; i < threads; i++) {
+        workers.push_back(std::make_unique<SearchWorker>(i));
+    }
+}
+
+void AI::setParallelMode(ParallelMode mode) {
+    if (mode != parallelMode) {
+        stopPonder();
+        parallelMode = mode;
+    }
+}
+
+void AI::setEvalMode(EvalMode mode) {
+    if (mode != evalMode) {
+        stopPonder();
+        evalMode = mode;
+    }
+}
+
+void AI::setSearchAlgorithm(SearchAlgorithm algorithm) {
+    if (algorithm != searchAlgorithm) {
+        stopPonder();
+        searchAlgorithm = algorithm;
+        tt.clear();
+    }
+}
+
+void AI::setOpeningBook(const OpeningBook* openingBook) {
+    if (openingBook != book) {
+        stopPonder();
+        book = openingBook;
+    }
+}
+
+void AI::setHashSize(int megabytes) {
+    stopPonder();
+    tt.resize(megabytes);
+}
+
+void AI::clearHash() {
+    stopPonder();
+    tt.clear();
+    for (auto& worker : workers) {
+        worker->endgame.clear();
+        worker->ordering.clear();
+    }
 }
 
 Move AI::getBestMove(const Board& board) {
-    nodesEvaluated = 0;
+    if (!isPondering()) {
+        return search(board, maxDepth, timeLimitMs, nodeLimit);
+    }
+    if (!ponderHitPending || board.getHash() != ponderBoard.getHash()) {
+        stopPonder();
+        return search(board, maxDepth, timeLimitMs, nodeLimit);
+    }
 
-    std::vector<Move> possibleMoves = board.getAllPossibleMoves(aiPlayer);
+    // Ponder hit: the background search has been on this position since the
+    // AI's last move. Time it spent counts against the budget, so a long
+    // enough think by the opponent means the move is ready at once.
+    int depthLimit = std::min(maxDepth, MAX_SEARCH_DEPTH - 1);
+    auto deadline = ponderStartTime + std::chrono::milliseconds(timeLimitMs);
+    while (!ponderDone) {
+        if (timeLimitMs > 0 ? std::chrono::steady_clock::now() >= deadline : completedDepth >= depthLimit) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    stopPonder();
+
+    if (completedDepth == 0) {
+        return search(board, maxDepth, timeLimitMs, nodeLimit);
+    }
+    SEARCH_LOG("Ponder move score: " << lastScore << " (Depth: " << completedDepth << ")");
+    return ponderMove;
+}
+
+bool AI::startPonder(const Board& board) {
+    stopPonder();
+
+    // The opponent's best reply from the last search, if the table has it
+    TTEntry entry;
+    if (!tt.probe(board.getCanonicalHash(), entry) || entry.move == NO_MOVE) {
+        return false;
+    }
+    Move reply = unpackMove(board.orientMove(entry.move), board.getPlayerPosition(opponent));
+    if (!board.isValidMove(reply, opponent)) {
+        return false;
+    }
+
+    ponderBoard = board;
+    ponderBoard.applyMove(reply, opponent);
+    if (!ponderBoard.canPlayerMove(aiPlayer)) {
+        return false;
+    }
+
+    ponderStop = false;
+    ponderDone = false;
+    ponderHitPending = false;
+    ponderStartTime = std::chrono::steady_clock::now();
+    int depthLimit = std::min(maxDepth, MAX_SEARCH_DEPTH - PONDER_EXTRA_DEPTH) + PONDER_EXTRA_DEPTH;
+    int timeLimit = timeLimitMs * PONDER_TIME_FACTOR;
+    ponderThread = std::thread([this, depthLimit, timeLimit]() {
+        ponderMove = search(ponderBoard, depthLimit, timeLimit, 0);
+        ponderDone = true;
+    });
+    return true;
+}
+
+bool AI::resolvePonder(const Board& board) {
+    if (!isPondering()) {
+        return false;
+    }
+    if (board.getHash() != ponderBoard.getHash()) {
+        ponderMisses++;
+        stopPonder();
+        return false;
+    }
+    ponderHits++;
+    ponderHitPending = true;
+    return true;
+}
+
+void AI::stopPonder() {
+    if (!isPondering()) {
+        return;
+    }
+    ponderStop = true;
+    ponderThread.join();
+    ponderStop = false;
+    ponderHitPending = false;
+}
+
+Move AI::search(const Board& board, int depthLimit, int timeLimit, long long nodeBudget) {
+    searchDepthLimit = std::min(depthLimit, MAX_SEARCH_DEPTH - 1);
+    searchTimeLimitMs = timeLimit;
+    searchNodeLimit = nodeBudget;
+    for (auto& worker : workers) {
+        worker->resetCounters();
+        worker->ordering.newSearch();
+    }
+    completedDepth = 0;
+    stopSearch = false;
+    searchStart = std::chrono::steady_clock::now();
+    publishProgress(0, 0, Move());
+
+    MoveList possibleMoves;
+    board.generateMoves(aiPlayer, possibleMoves);
 
     if (possibleMoves.empty()) {
         // No valid moves available
+        finishStats(nullptr, 0, false);
         return Move();
     }
+    removeMirroredMoves(board, possibleMoves);
+
+    // Opening book: a stored move for this position (or its mirror image) replaces the search
+    BookEntry bookEntry;
+    if (book && book->probe(board.getCanonicalHash(), bookEntry)) {
+        Move bookMove = unpackMove(board.orientMove(bookEntry.move), board.getPlayerPosition(aiPlayer));
+        if (board.isValidMove(bookMove, aiPlayer)) {
+            nodesEvaluated = 0;
+            betaCutoffs = 0;
+            firstMoveCutoffs = 0;
+            lastScore = bookEntry.score;
+            finishStats(nullptr, 0, true);
+            SEARCH_LOG("Book move score: " << bookEntry.score);
+            return bookMove;
+        }
+    }
+
+    tt.newSearch();
+
+    // Search the stored best move first
+    TTEntry entry;
+    if (tt.probe(board.getCanonicalHash(), entry) && entry.move != NO_MOVE) {
+        PackedMove hashMove = board.orientMove(entry.move);
+        for (auto& move : possibleMoves) {
+            if (packMove(move) == hashMove) {
+                std::swap(move, possibleMoves[0]);
+                break;
+            }
+        }
+    }
 
     Move bestMove = possibleMoves[0];
     int bestScore = std::numeric_limits<int>::min();
-    int alpha = std::numeric_limits<int>::min();
-    int beta = std::numeric_limits<int>::max();
 
-    std::cout << "AI evaluating " << possibleMoves.size() << " possible moves..." << std::endl;
+    SEARCH_LOG("AI evaluating " << possibleMoves.size() << " possible moves...");
+
+    // Lazy SMP: helper threads search the same position and fill the shared table.
+    // YBWC: helper threads wait for siblings published at split points.
+    std::vector<std::thread> helpers;
+    poolActive = true;
+    for (size_t i = 1; i < workers.size(); i++) {
+        SearchWorker& helper = *workers[i];
+        if (parallelMode == ParallelMode::YBWC) {
+            helpers.emplace_back([this, &helper]() { poolLoop(helper); });
+        } else {
+            helpers.emplace_back([this, &helper, &board]() { helperSearch(helper, board); });
+        }
+    }
+
+    // One working board per thread; moves are made and unmade in place
+    SearchWorker& mainWorker = *workers[0];
+    mainWorker.board = board;
+
+    // Nodes and time of each completed iteration
+    IterationStats iterations[MAX_SEARCH_DEPTH];
+    int iterationCount = 0;
+    long long iterationStartNodes = 0;
+    auto iterationStart = searchStart;
+
+    // Iterative deepening
+    for (int depth = 1; depth <= searchDepthLimit; depth++) {
+        Move iterationMove;
+        int iterationScore;
+        int parityScore = (iterationCount >= 2) ? iterations[iterationCount - 2].score : bestScore;
+        if (!searchIteration(mainWorker, possibleMoves, depth, bestScore, parityScore, iterationMove,
+                             iterationScore)) {
+            break;
+        }
+
+        bestMove = iterationMove;
+        bestScore = iterationScore;
+        completedDepth = depth;
+        publishProgress(depth, bestScore, bestMove);
+
+        // Helpers' counts are their last published values
+        long long nodesNow = mainWorker.nodes;
+        for (size_t i = 1; i < workers.size(); i++) {
+            nodesNow += workers[i]->publishedNodes.load(std::memory_order_relaxed);
+        }
+        auto now = std::chrono::steady_clock::now();
+        iterations[iterationCount++] = IterationStats{
+            depth, bestScore, nodesNow - iterationStartNodes,
+            std::chrono::duration<double, std::milli>(now - iterationStart).count()};
+        iterationStartNodes = nodesNow;
+        iterationStart = now;
+
+        // Search the best move first in the next iteration
+        for (auto& move : possibleMoves) {
+            if (packMove(move) == packMove(bestMove)) {
+                std::swap(move, possibleMoves[0]);
+                break;
+            }
+        }
+
+        // A forced win or loss will not change with more depth
+        if (std::abs(bestScore) >= WIN_SCORE - MAX_SEARCH_DEPTH) {
+            break;
+        }
+
+        // The next iteration costs more than all previous ones together;
+        // do not start it unless most of the budget is left
+        if (searchTimeLimitMs > 0) {
+            auto elapsed = std::chrono::steady_clock::now() - searchStart;
+            if (elapsed >= std::chrono::milliseconds(searchTimeLimitMs) / 2) {
+                break;
+            }
+        }
+    }
+
+    // The main thread's result is final
+    stopSearch = true;
+    poolActive = false;
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+
+    nodesEvaluated = 0;
+    betaCutoffs = 0;
+    firstMoveCutoffs = 0;
+    for (const auto& worker : workers) {
+        nodesEvaluated += worker->nodes;
+        betaCutoffs += worker->betaCutoffs;
+        firstMoveCutoffs += worker->firstMoveCutoffs;
+    }
+
+    lastScore = bestScore;
+    finishStats(iterations, iterationCount, false);
+
+    SEARCH_LOG("Best move score: " << bestScore << " (Depth: " << completedDepth
+               << ", Nodes evaluated: " << nodesEvaluated
+               << ", First-move cutoffs: " << static_cast<int>(getFirstMoveCutoffRate() * 100) << "%)");
+
+    return bestMove;
+}
+
+void AI::helperSearch(SearchWorker& worker, const Board& board) {
+    worker.board = board;
+
+    MoveList moves;
+    worker.board.generateMoves(aiPlayer, moves);
+    removeMirroredMoves(worker.board, moves);
+
+    // Diversify: each helper starts from a different root move and
+    // odd helpers run one ply ahead of the main thread
+    std::rotate(moves.begin(), moves.begin() + (worker.id % moves.size()), moves.end());
+
+    int previousScore = 0;
+    int parityScore = 0;    // Score two iterations back (previousScore until there is one)
+    int completed = 0;
+    for (int depth = 1 + (worker.id & 1); depth <= searchDepthLimit; depth++) {
+        Move iterationMove;
+        int iterationScore;
+        if (!searchIteration(worker, moves, depth, previousScore, (completed >= 2) ? parityScore : previousScore,
+                             iterationMove, iterationScore)) {
+            break;
+        }
+        parityScore = previousScore;
+        previousScore = iterationScore;
+        completed++;
+
+        for (auto& move : moves) {
+            if (packMove(move) == packMove(iterationMove)) {
+                std::swap(move, moves[0]);
+                break;
+            }
+        }
+
+        if (std::abs(iterationScore) >= WIN_SCORE - MAX_SEARCH_DEPTH) {
+            break;
+        }
+    }
+}
+
+bool AI::searchIteration(SearchWorker& worker, MoveList& moves, int depth, int previousScore,
+                         int parityScore, Move& bestMove, int& bestScore) {
+    if (searchAlgorithm == SearchAlgorithm::MTDF) {
+        return mtdf(worker, moves, depth, (depth == 1) ? 0 : parityScore, bestMove, bestScore);
+    }
+
+    // Without a previous score worth trusting, search the full window
+    if (searchAlgorithm != SearchAlgorithm::NEGAMAX_PVS || depth == 1 ||
+        std::abs(previousScore) >= WIN_SCORE - MAX_SEARCH_DEPTH) {
+        return searchRoot(worker, moves, depth, -SCORE_INFINITY, SCORE_INFINITY, bestMove, bestScore);
+    }
+
+    // Aspiration window: widen the failing side until the score falls inside
+    int delta = ASPIRATION_WINDOW;
+    int alpha = previousScore - delta;
+    int beta = previousScore + delta;
+    while (true) {
+        if (!searchRoot(worker, moves, depth, alpha, beta, bestMove, bestScore)) {
+            return false;
+        }
+        if (bestScore <= alpha) {
+            alpha = std::max(bestScore - delta, -SCORE_INFINITY);
+        } else if (bestScore >= beta) {
+            beta = std::min(bestScore + delta, SCORE_INFINITY);
+        } else {
+            return true;
+        }
+        delta *= 4;
+    }
+}
+
+bool AI::mtdf(SearchWorker& worker, MoveList& moves, int depth, int guess, Move& bestMove, int& bestScore) {
+    int lowerBound = -SCORE_INFINITY;
+    int upperBound = SCORE_INFINITY;
+    int score = guess;
+    bool failedHigh = false;
+
+    // Each zero-window pass moves one bound to the fail-soft score it returns;
+    // the table keeps the work of earlier passes
+    while (lowerBound < upperBound) {
+        int beta = (score == lowerBound) ? score + 1 : score;
+        Move passMove;
+        if (!searchRoot(worker, moves, depth, beta - 1, beta, passMove, score)) {
+            return false;
+        }
+        if (score < beta) {
+            upperBound = score;
+            // No pass has proved a move yet: keep the one with the best bound
+            if (!failedHigh) {
+                bestMove = passMove;
+            }
+        } else {
+            // Only a fail-high pass proves its move reaches the bound; search
+            // it first in the next pass
+            lowerBound = score;
+            bestMove = passMove;
+            failedHigh = true;
+            for (auto& move : moves) {
+                if (packMove(move) == packMove(passMove)) {
+                    std::swap(move, moves[0]);
+                    break;
+                }
+            }
+        }
+    }
+
+    bestScore = score;
+    return true;
+}
+
+bool AI::searchRoot(SearchWorker& worker, MoveList& moves, int depth, int alpha, int beta,
+                    Move& bestMove, int& bestScore) {
+    Board& board = worker.board;
+    bestMove = moves[0];
+    bestScore = -SCORE_INFINITY;
+    int alphaOrig = alpha;
 
     // Evaluate each possible move
-    for (const auto& move : possibleMoves) {
-        // Create a copy of the board and apply the move
-        Board tempBoard = board.copy();
-        tempBoard.applyMove(move, aiPlayer);
+    for (const auto& move : moves) {
+        UndoInfo undo;
+        board.makeMove(move, aiPlayer, undo);
+
+        int score;
+        if (searchAlgorithm != SearchAlgorithm::MINMAX) {
+            score = searchChild<false>(worker, depth - 1, alpha, beta, 1, &move == moves.begin());
+        } else {
+            // Run minmax from opponent's perspective (minimizing)
+            score = minmax(worker, depth - 1, false, alpha, beta, 1);
+        }
+
+        board.unmakeMove(aiPlayer, undo);
 
-        // Run minmax from opponent's perspective (minimizing)
-        int score = minmax(tempBoard, maxDepth - 1, false, alpha, beta);
+        if (aborted(worker)) {
+            return false;
+        }
 
         // Update best move if this is better
         if (score > bestScore) {
@@ -41,24 +498,276 @@ Move AI::getBestMove(const Board& board) {
 
         // Update alpha
         alpha = std::max(alpha, bestScore);
+
+        // Above an aspiration window: the caller widens it and searches again
+        if (alpha >= beta) {
+            break;
+        }
+
+        // YBWC: the first root move sets the bound, the rest run in parallel
+        if (&move == moves.begin() && moves.size() > 1 && canSplit(depth, 0)) {
+            SplitPoint splitPoint(board, aiPlayer, depth, 0, true, worker.currentSplit,
+                                  alpha, beta, bestScore, packMove(bestMove));
+            MoveList siblings;
+            for (const Move* sibling = moves.begin() + 1; sibling != moves.end(); ++sibling) {
+                siblings.push_back(*sibling);
+            }
+            splitSearch(worker, splitPoint, siblings);
+            if (aborted(worker)) {
+                return false;
+            }
+            bestScore = splitPoint.bestEval;
+            bestMove = unpackMove(splitPoint.bestMove, board.getPlayerPosition(aiPlayer));
+            break;
+        }
     }
 
-    std::cout << "Best move score: " << bestScore << " (Nodes evaluated: " << nodesEvaluated << ")" << std::endl;
+    Bound bound = Bound::EXACT;
+    if (bestScore <= alphaOrig) {
+        bound = Bound::UPPER;
+    } else if (bestScore >= beta) {
+        bound = Bound::LOWER;
+    }
+    tt.store(board.getCanonicalHash(), scoreToTT(bestScore, depth), bound, depth,
+             board.orientMove(packMove(bestMove)));
 
-    return bestMove;
+    return true;
 }
 
-int AI::minmax(Board& board, int depth, bool isMaximizing, int alpha, int beta) {
-    nodesEvaluated++;
+bool AI::canSplit(int depth, int ply) const {
+    return parallelMode == ParallelMode::YBWC && workers.size() > 1 &&
+           depth >= YBWC_MIN_SPLIT_DEPTH && ply <= YBWC_MAX_SPLIT_PLY;
+}
 
-    // Terminal conditions
-    if (depth == 0) {
-        return evaluate(board);
+void AI::splitSearch(SearchWorker& worker, SplitPoint& splitPoint, const MoveList& siblings) {
+    std::vector<SplitTask> tasks;
+    tasks.reserve(siblings.size());
+    for (const auto& move : siblings) {
+        tasks.push_back({&splitPoint, move});
+    }
+    splitPoint.pending = static_cast<int>(tasks.size());
+
+    // Pushed in reverse so the owner pops siblings in move order
+    // while thieves take the last ones. A task that does not fit in the
+    // deque is searched here at once.
+    for (auto it = tasks.rbegin(); it != tasks.rend(); ++it) {
+        if (!worker.deque.push(&*it)) {
+            runTask(worker, *it);
+        }
+    }
+
+    // Help until every sibling is done: own tasks first, then tasks of
+    // this split point that other threads have split further
+    while (splitPoint.pending.load(std::memory_order_acquire) > 0) {
+        SplitTask* task = worker.deque.popWithin(&splitPoint);
+        if (!task) {
+            task = stealTask(worker, &splitPoint);
+        }
+        if (task) {
+            runTask(worker, *task);
+            continue;
+        }
+        if (worker.id == 0 && timeUp()) {
+            stopSearch = true;
+        }
+        std::this_thread::yield();
+    }
+}
+
+void AI::runTask(SearchWorker& worker, SplitTask& task) {
+    SplitPoint& splitPoint = *task.splitPoint;
+    int alpha = splitPoint.alpha.load(std::memory_order_relaxed);
+    int beta = splitPoint.beta.load(std::memory_order_relaxed);
+
+    if (!stopSearch.load(std::memory_order_relaxed) && !splitPoint.cancelled() && alpha < beta) {
+        // Search from the split node on this thread's board
+        Board savedBoard = worker.board;
+        SplitPoint* savedSplit = worker.currentSplit;
+        worker.board = splitPoint.board;
+        worker.currentSplit = &splitPoint;
+
+        UndoInfo undo;
+        worker.board.makeMove(task.move, splitPoint.player, undo);
+        int eval;
+        if (searchAlgorithm != SearchAlgorithm::MINMAX) {
+            // Negamax split points maximize for the side to move
+            int depth = splitPoint.depth - 1;
+            int ply = splitPoint.ply + 1;
+            eval = (splitPoint.player == aiPlayer)
+                ? searchChild<false>(worker, depth, alpha, beta, ply, false)
+                : searchChild<true>(worker, depth, alpha, beta, ply, false);
+        } else {
+            eval = minmax(worker, splitPoint.depth - 1, !splitPoint.isMaximizing,
+                          alpha, beta, splitPoint.ply + 1);
+        }
+        worker.board.unmakeMove(splitPoint.player, undo);
+
+        if (!aborted(worker)) {
+            std::lock_guard<std::mutex> guard(splitPoint.lock);
+            if (splitPoint.isMaximizing ? eval > splitPoint.bestEval : eval < splitPoint.bestEval) {
+                splitPoint.bestEval = eval;
+                splitPoint.bestMove = packMove(task.move);
+            }
+            if (splitPoint.isMaximizing) {
+                splitPoint.alpha = std::max(splitPoint.alpha.load(), eval);
+            } else {
+                splitPoint.beta = std::min(splitPoint.beta.load(), eval);
+            }
+            if (splitPoint.beta.load() <= splitPoint.alpha.load()) {
+                splitPoint.cutoff = true;
+            }
+        }
+
+        worker.board = savedBoard;
+        worker.currentSplit = savedSplit;
+    }
+
+    splitPoint.pending.fetch_sub(1, std::memory_order_release);
+}
+
+SplitTask* AI::stealTask(SearchWorker& worker, const SplitPoint* splitPoint) {
+    size_t count = workers.size();
+    for (size_t i = 1; i < count; i++) {
+        SearchWorker& victim = *workers[(worker.id + i) % count];
+        if (SplitTask* task = victim.deque.steal(splitPoint)) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void AI::poolLoop(SearchWorker& worker) {
+    while (poolActive.load(std::memory_order_relaxed)) {
+        if (SplitTask* task = stealTask(worker, nullptr)) {
+            runTask(worker, *task);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+void AI::publishProgress(int depth, int score, const Move& bestMove) {
+    std::lock_guard<std::mutex> guard(progressLock);
+    progress.depth = depth;
+    progress.score = score;
+    progress.bestMove = bestMove;
+}
+
+SearchProgress AI::getProgress() const {
+    SearchProgress snapshot;
+    {
+        std::lock_guard<std::mutex> guard(progressLock);
+        snapshot = progress;
+    }
+    snapshot.nodes = 0;
+    for (const auto& worker : workers) {
+        snapshot.nodes += worker->publishedNodes.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+void AI::finishStats(const IterationStats* iterations, int iterationCount, bool fromBook) {
+    SearchStats stats{};
+    for (const auto& worker : workers) {
+        stats.nodes += worker->nodes;
+        stats.leafEvals += worker->leafEvals;
+        stats.betaCutoffs += worker->betaCutoffs;
+        stats.firstMoveCutoffs += worker->firstMoveCutoffs;
+        stats.hashProbes += worker->hashProbes;
+        stats.hashHits += worker->hashHits;
+        stats.maxPly = std::max(stats.maxPly, worker->maxPly);
+    }
+    stats.completedDepth = completedDepth;
+    stats.timeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - searchStart).count();
+    stats.fromBook = fromBook;
+    stats.iterationCount = iterationCount;
+    std::copy(iterations, iterations + iterationCount, stats.iterations);
+
+    {
+        std::lock_guard<std::mutex> guard(progressLock);
+        lastStats = stats;
+    }
+    if (statsLog) {
+        writeSearchStatsJson(*statsLog, stats);
+        *statsLog << '\n' << std::flush;
+    }
+}
+
+SearchStats AI::getLastSearchStats() const {
+    std::lock_guard<std::mutex> guard(progressLock);
+    return lastStats;
+}
+
+void AI::setStatsLog(std::ostream* out) {
+    if (out != statsLog) {
+        stopPonder();
+        statsLog = out;
+    }
+}
+
+void writeSearchStatsJson(std::ostream& out, const SearchStats& stats) {
+    out << "{\"nodes\":" << stats.nodes << ",\"leaf_evals\":" << stats.leafEvals
+        << ",\"beta_cutoffs\":" << stats.betaCutoffs << ",\"first_move_cutoffs\":" << stats.firstMoveCutoffs
+        << ",\"first_move_cutoff_rate\":" << stats.firstMoveCutoffRate()
+        << ",\"hash_probes\":" << stats.hashProbes << ",\"hash_hits\":" << stats.hashHits
+        << ",\"effective_branching_factor\":" << stats.effectiveBranchingFactor()
+        << ",\"completed_depth\":" << stats.completedDepth << ",\"max_ply\":" << stats.maxPly
+        << ",\"time_ms\":" << stats.timeMs << ",\"from_book\":" << (stats.fromBook ? "true" : "false")
+        << ",\"iterations\":[";
+    for (int i = 0; i < stats.iterationCount; i++) {
+        const IterationStats& iteration = stats.iterations[i];
+        out << (i ? "," : "") << "{\"depth\":" << iteration.depth << ",\"score\":" << iteration.score
+            << ",\"nodes\":" << iteration.nodes << ",\"time_ms\":" << iteration.timeMs << "}";
+    }
+    out << "]}";
+}
+
+bool AI::timeUp() const {
+    if (ponderStop.load(std::memory_order_relaxed) || stopRequested.load(std::memory_order_relaxed)) {
+        return true;
+    }
+    if (completedDepth == 0) {
+        return false;
+    }
+    if (searchNodeLimit > 0) {
+        long long nodes = 0;
+        for (const auto& worker : workers) {
+            nodes += worker->publishedNodes.load(std::memory_order_relaxed);
+        }
+        if (nodes >= searchNodeLimit) {
+            return true;
+        }
+    }
+    if (searchTimeLimitMs <= 0) {
+        return false;
+    }
+    auto elapsed = std::chrono::steady_clock::now() - searchStart;
+    return elapsed >= std::chrono::milliseconds(searchTimeLimitMs);
+}
+
+int AI::minmax(SearchWorker& worker, int depth, bool isMaximizing, int alpha, int beta, int ply) {
+    if (aborted(worker)) {
+        return 0;
+    }
+
+    Board& board = worker.board;
+    worker.nodes++;
+    worker.maxPly = std::max(worker.maxPly, ply);
+
+    // Every TIME_CHECK_INTERVAL nodes: publish the node count for progress
+    // reports; the main thread also checks the clock
+    if ((worker.nodes & (TIME_CHECK_INTERVAL - 1)) == 0) {
+        worker.publishedNodes.store(worker.nodes, std::memory_order_relaxed);
+        if (worker.id == 0 && timeUp()) {
+            stopSearch = true;
+            return 0;
+        }
     }
 
     Player currentPlayer = isMaximizing ? aiPlayer : opponent;
 
-    // Check if current player can move
+    // Check if current player can move. This is a single mask test, so it
+    // runs at the horizon too: a trapped piece is a lost game, not a score.
     if (!board.canPlayerMove(currentPlayer)) {
         // Current player loses
         if (isMaximizing) {
@@ -70,56 +779,294 @@ int AI::minmax(Board& board, int depth, bool isMaximizing, int alpha, int beta)
         }
     }
 
-    std::vector<Move> possibleMoves = board.getAllPossibleMoves(currentPlayer);
+    // Players walled off from each other: the result is known exactly.
+    // Not at the horizon, where a solved result would only replace the
+    // static evaluation of one leaf.
+    bool moverWins;
+    if (depth > 0 && worker.endgame.probe(board, currentPlayer, moverWins)) {
+        return (moverWins == isMaximizing) ? WIN_SCORE + depth : -WIN_SCORE - depth;
+    }
 
-    if (possibleMoves.empty()) {
-        // No valid moves, current player loses
-        if (isMaximizing) {
-            return -100000 - depth;
-        } else {
-            return 100000 + depth;
-        }
+    // Terminal conditions
+    if (depth == 0) {
+        worker.leafEvals++;
+        return evaluate(board);
+    }
+
+    // Transposition table: reuse bounds from an earlier visit of this
+    // position or its mirror image (stored moves are in canonical orientation)
+    uint64_t key = board.getCanonicalHash();
+    PackedMove hashMove = NO_MOVE;
+    int ttScore;
+    if (probeTT(worker, key, depth, alpha, beta, hashMove, ttScore)) {
+        return ttScore;
     }
+    hashMove = board.orientMove(hashMove);
+
+    // Window actually searched, for classifying the result
+    int alphaOrig = alpha;
+    int betaOrig = beta;
 
-    if (isMaximizing) {
-        // Maximizing player (AI)
-        int maxEval = std::numeric_limits<int>::min();
+    // Maximizing player (AI) raises alpha, minimizing player (Opponent) lowers beta
+    int bestEval = isMaximizing ? std::numeric_limits<int>::min() : std::numeric_limits<int>::max();
+    PackedMove bestMove = NO_MOVE;
 
-        for (const auto& move : possibleMoves) {
-            Board tempBoard = board.copy();
-            tempBoard.applyMove(move, currentPlayer);
+    // Hash move, then killers, removals next to the opponent and history
+    MovePicker picker(board, currentPlayer, hashMove, worker.ordering, ply);
+    Move move;
+    int movesSearched = 0;
 
-            int eval = minmax(tempBoard, depth - 1, false, alpha, beta);
-            maxEval = std::max(maxEval, eval);
+    while (picker.next(move)) {
+        UndoInfo undo;
+        board.makeMove(move, currentPlayer, undo);
+
+        int eval = minmax(worker, depth - 1, !isMaximizing, alpha, beta, ply + 1);
+
+        board.unmakeMove(currentPlayer, undo);
+
+        if (aborted(worker)) {
+            return 0;
+        }
+
+        movesSearched++;
+
+        if (isMaximizing ? eval > bestEval : eval < bestEval) {
+            bestEval = eval;
+            bestMove = packMove(move);
+        }
+        if (isMaximizing) {
             alpha = std::max(alpha, eval);
+        } else {
+            beta = std::min(beta, eval);
+        }
 
-            // Alpha-Beta pruning
-            if (beta <= alpha) {
+        // Alpha-Beta pruning
+        if (beta <= alpha) {
+            worker.betaCutoffs++;
+            if (movesSearched == 1) {
+                worker.firstMoveCutoffs++;
+            }
+            worker.ordering.recordCutoff(currentPlayer, bestMove, ply, depth);
+            break;
+        }
+
+        // YBWC: the eldest brother is done, search the younger ones in parallel
+        if (movesSearched == 1 && canSplit(depth, ply)) {
+            MoveList siblings;
+            while (picker.next(move)) {
+                siblings.push_back(move);
+            }
+            if (siblings.empty()) {
                 break;
             }
+            SplitPoint splitPoint(board, currentPlayer, depth, ply, isMaximizing, worker.currentSplit,
+                                  alpha, beta, bestEval, bestMove);
+            splitSearch(worker, splitPoint, siblings);
+            if (aborted(worker)) {
+                return 0;
+            }
+            bestEval = splitPoint.bestEval;
+            bestMove = splitPoint.bestMove;
+            if (splitPoint.cutoff) {
+                worker.betaCutoffs++;
+                worker.ordering.recordCutoff(currentPlayer, bestMove, ply, depth);
+            }
+            break;
         }
+    }
+
+    // An aborted search has no reliable result
+    if (aborted(worker)) {
+        return 0;
+    }
 
-        return maxEval;
-    } else {
-        // Minimizing player (Opponent)
-        int minEval = std::numeric_limits<int>::max();
+    Bound bound = Bound::EXACT;
+    if (bestEval <= alphaOrig) {
+        bound = Bound::UPPER;
+    } else if (bestEval >= betaOrig) {
+        bound = Bound::LOWER;
+    }
+    tt.store(key, scoreToTT(bestEval, depth), bound, depth, board.orientMove(bestMove));
 
-        for (const auto& move : possibleMoves) {
-            Board tempBoard = board.copy();
-            tempBoard.applyMove(move, currentPlayer);
+    return bestEval;
+}
 
-            int eval = minmax(tempBoard, depth - 1, true, alpha, beta);
-            minEval = std::min(minEval, eval);
-            beta = std::min(beta, eval);
+bool AI::probeTT(SearchWorker& worker, uint64_t key, int depth, int& alpha, int& beta, PackedMove& hashMove,
+                 int& score) const {
+    TTEntry entry;
+    worker.hashProbes++;
+    if (!tt.probe(key, entry)) {
+        return false;
+    }
+    worker.hashHits++;
+
+    hashMove = entry.move;
+    if (entry.depth < depth) {
+        return false;
+    }
+
+    score = scoreFromTT(entry.score, depth);
+    switch (entry.bound()) {
+        case Bound::EXACT:
+            return true;
+        case Bound::LOWER:
+            alpha = std::max(alpha, score);
+            break;
+        case Bound::UPPER:
+            beta = std::min(beta, score);
+            break;
+        case Bound::NONE:
+            break;
+    }
+    return alpha >= beta;
+}
+
+template <bool ChildAiToMove>
+int AI::searchChild(SearchWorker& worker, int depth, int alpha, int beta, int ply, bool firstChild) {
+    if (firstChild) {
+        return -negamax<ChildAiToMove>(worker, depth, -beta, -alpha, ply);
+    }
+
+    // Null window: only proves whether the move beats alpha
+    int score = -negamax<ChildAiToMove>(worker, depth, -alpha - 1, -alpha, ply);
+    if (score > alpha && score < beta && !aborted(worker)) {
+        score = -negamax<ChildAiToMove>(worker, depth, -beta, -alpha, ply);
+    }
+    return score;
+}
+
+template <bool AiToMove>
+int AI::negamax(SearchWorker& worker, int depth, int alpha, int beta, int ply) {
+    if (aborted(worker)) {
+        return 0;
+    }
+
+    Board& board = worker.board;
+    worker.nodes++;
+    worker.maxPly = std::max(worker.maxPly, ply);
+
+    // Every TIME_CHECK_INTERVAL nodes: publish the node count for progress
+    // reports; the main thread also checks the clock
+    if ((worker.nodes & (TIME_CHECK_INTERVAL - 1)) == 0) {
+        worker.publishedNodes.store(worker.nodes, std::memory_order_relaxed);
+        if (worker.id == 0 && timeUp()) {
+            stopSearch = true;
+            return 0;
+        }
+    }
+
+    Player currentPlayer = AiToMove ? aiPlayer : opponent;
+
+    // A trapped side to move has lost; prefer later losses
+    if (!board.canPlayerMove(currentPlayer)) {
+        return -WIN_SCORE - depth;
+    }
+
+    // Players walled off from each other: the result is known exactly.
+    // Not at the horizon, where a solved result would only replace the
+    // static evaluation of one leaf.
+    bool moverWins;
+    if (depth > 0 && worker.endgame.probe(board, currentPlayer, moverWins)) {
+        return moverWins ? WIN_SCORE + depth : -WIN_SCORE - depth;
+    }
+
+    // The evaluation is from the AI's point of view
+    if (depth == 0) {
+        worker.leafEvals++;
+        int score = evaluate(board);
+        return AiToMove ? score : -score;
+    }
+
+    // Transposition table: reuse bounds from an earlier visit of this
+    // position or its mirror image (stored moves are in canonical orientation)
+    uint64_t key = board.getCanonicalHash();
+    PackedMove hashMove = NO_MOVE;
+    int ttScore;
+    if (probeTT(worker, key, depth, alpha, beta, hashMove, ttScore)) {
+        return ttScore;
+    }
+    hashMove = board.orientMove(hashMove);
+
+    // Window actually searched, for classifying the result
+    int alphaOrig = alpha;
+    int betaOrig = beta;
+
+    int bestEval = -SCORE_INFINITY;
+    PackedMove bestMove = NO_MOVE;
+
+    // Hash move, then killers, removals next to the opponent and history
+    MovePicker picker(board, currentPlayer, hashMove, worker.ordering, ply);
+    Move move;
+    int movesSearched = 0;
+
+    while (picker.next(move)) {
+        UndoInfo undo;
+        board.makeMove(move, currentPlayer, undo);
+
+        int score = searchChild<!AiToMove>(worker, depth - 1, alpha, beta, ply + 1, movesSearched == 0);
+
+        board.unmakeMove(currentPlayer, undo);
 
-            // Alpha-Beta pruning
-            if (beta <= alpha) {
+        if (aborted(worker)) {
+            return 0;
+        }
+
+        movesSearched++;
+
+        if (score > bestEval) {
+            bestEval = score;
+            bestMove = packMove(move);
+        }
+        alpha = std::max(alpha, score);
+
+        if (alpha >= beta) {
+            worker.betaCutoffs++;
+            if (movesSearched == 1) {
+                worker.firstMoveCutoffs++;
+            }
+            worker.ordering.recordCutoff(currentPlayer, bestMove, ply, depth);
+            break;
+        }
+
+        // YBWC: the eldest brother is done, search the younger ones in parallel
+        if (movesSearched == 1 && canSplit(depth, ply)) {
+            MoveList siblings;
+            while (picker.next(move)) {
+                siblings.push_back(move);
+            }
+            if (siblings.empty()) {
                 break;
             }
+            SplitPoint splitPoint(board, currentPlayer, depth, ply, true, worker.currentSplit,
+                                  alpha, beta, bestEval, bestMove);
+            splitSearch(worker, splitPoint, siblings);
+            if (aborted(worker)) {
+                return 0;
+            }
+            bestEval = splitPoint.bestEval;
+            bestMove = splitPoint.bestMove;
+            if (splitPoint.cutoff) {
+                worker.betaCutoffs++;
+                worker.ordering.recordCutoff(currentPlayer, bestMove, ply, depth);
+            }
+            break;
         }
+    }
 
-        return minEval;
+    // An aborted search has no reliable result
+    if (aborted(worker)) {
+        return 0;
     }
+
+    Bound bound = Bound::EXACT;
+    if (bestEval <= alphaOrig) {
+        bound = Bound::UPPER;
+    } else if (bestEval >= betaOrig) {
+        bound = Bound::LOWER;
+    }
+    tt.store(key, scoreToTT(bestEval, depth), bound, depth, board.orientMove(bestMove));
+
+    return bestEval;
 }
 
 int AI::evaluate(const Board& board) const {
@@ -133,14 +1080,19 @@ int AI::evaluate(const Board& board) const {
     Position oppPos = board.getPlayerPosition(opponent);
     int positionScore = getPositionValue(aiPos) - getPositionValue(oppPos);
 
+    // Territory heuristic: who controls the space left on the board
+    int territoryScore = 0;
+    if (evalMode == EvalMode::TERRITORY) {
+        territoryScore = getTerritoryValue(board) * TERRITORY_WEIGHT;
+    }
+
     // Total score
-    return mobilityScore + positionScore;
+    return mobilityScore + positionScore + territoryScore;
 }
 
 int AI::getMobility(const Board& board, Player player) const {
-    Position playerPos = board.getPlayerPosition(player);
-    std::vector<Position> validNeighbors = board.getValidNeighbors(playerPos);
-    return validNeighbors.size();
+    // One AND with the neighbor mask plus a popcount
+    return board.getMobility(player);
 }
 
 int AI::getPositionValue(const Position& pos) const {
@@ -155,3 +1107,9 @@ int AI::getPositionValue(const Position& pos) const {
     // Higher value for positions closer to center
     return (BOARD_SIZE - distanceFromCenter) * 2;
 }
+
+int AI::getTerritoryValue(const Board& board) const {
+    Territory territory = board.getTerritory();
+    int difference = territory.player1 - territory.player2;
+    return (aiPlayer == Player::PLAYER1) ? difference : -difference;
+}
@@ -1,7 +1,131 @@
 #include "../include/api.h"
 #include "../include/game.h"
 #include "../include/ai.h"
+#include <algorithm>
+#include <atomic>
 #include <cstring>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+// Transposition table size of engines created from now on (MB)
+static int aiHashSizeMB = DEFAULT_HASH_MB;
+
+// Search threads of engines created from now on
+static int aiThreads = 1;
+
+// How extra search threads are used
+static ParallelMode aiParallelMode = ParallelMode::LAZY_SMP;
+
+// Leaf evaluation for AI searches
+static EvalMode aiEvalMode = EvalMode::MOBILITY;
+
+// Tree search for AI searches
+static SearchAlgorithm aiSearchAlgorithm = SearchAlgorithm::NEGAMAX_PVS;
+
+// Opening book consulted before every AI search (empty until loaded).
+// Mapped at most once: every session's engine may be probing it.
+static OpeningBook openingBook;
+static std::mutex openingBookLock;
+
+static_assert(sizeof(StateBlock) == 64, "state block layout is shared with the Dart client");
+static_assert(MAX_SEARCH_DEPTH <= SEARCH_STATS_MAX_ITERATIONS, "SearchStatsData holds every iteration");
+
+// Depth limit of getAIMove unless configured (fast response)
+static const int DEFAULT_AI_DEPTH = 2;
+
+// What a game handle points to: the game and an engine that lives as long
+// as it, so hash entries and move-ordering history carry over between turns
+struct GameSession {
+    Game game;
+    AI ai;
+    int depth;          // Depth limit of getAIMove
+    int timeLimitMs;    // Time budget of getAIMove (0 = none)
+    int hashSizeMB;     // Current transposition table size
+
+    // Published copy of the game state, read in place by clients
+    StateBlock stateBlock;
+
+    // Asynchronous search started by startAISearch
+    std::thread searchThread;
+    std::atomic<bool> searchDone;
+    bool hasSearchResult;   // searchResult belongs to the current position
+    Move searchResult;
+
+    // JSON-lines file the engine appends search statistics to (setSearchStatsLog)
+    std::ofstream statsFile;
+
+    GameSession()
+        : ai(Player::PLAYER1, DEFAULT_AI_DEPTH, aiHashSizeMB, aiThreads),
+          depth(DEFAULT_AI_DEPTH), timeLimitMs(0), hashSizeMB(aiHashSizeMB),
+          searchDone(false), hasSearchResult(false) {
+        stateBlock = StateBlock();
+        stateBlock.layout = STATE_BLOCK_LAYOUT;
+        publishState();
+    }
+
+    ~GameSession() {
+        endSearch(true);
+        ai.setStatsLog(nullptr);
+    }
+
+    // Copy the game state into the state block and bump its version
+    void publishState() {
+        const Board& board = game.getBoard();
+        Bitboard removed = board.getRemovedMask();
+        int player1Sq = board.getPlayerSquare(Player::PLAYER1);
+        int player2Sq = board.getPlayerSquare(Player::PLAYER2);
+
+        for (int sq = 0; sq < NUM_SQUARES; sq++) {
+            stateBlock.cells[sq] = (removed & squareBit(sq)) ? 3 : 0;
+        }
+        stateBlock.cells[player1Sq] = 1;
+        stateBlock.cells[player2Sq] = 2;
+        stateBlock.player1Square = static_cast<uint8_t>(player1Sq);
+        stateBlock.player2Square = static_cast<uint8_t>(player2Sq);
+        stateBlock.currentPlayer = (game.getCurrentPlayer() == Player::PLAYER1) ? 1 : 2;
+        stateBlock.gameOver = game.isGameOver() ? 1 : 0;
+        stateBlock.winner = game.isGameOver() ? ((game.getWinner() == Player::PLAYER1) ? 1 : 2) : 0;
+        stateBlock.turnCount = static_cast<uint16_t>(game.getTurnCount());
+        stateBlock.version++;
+    }
+
+    // Wait for the asynchronous search, if any, stopping it first if asked.
+    // Every export that uses the engine calls this before touching it.
+    void endSearch(bool cancel) {
+        if (!searchThread.joinable()) {
+            return;
+        }
+        if (cancel) {
+            ai.requestStop();
+        }
+        searchThread.join();
+        ai.clearStopRequest();
+    }
+};
+
+static GameSession* sessionOf(void* game) {
+    return static_cast<GameSession*>(game);
+}
+
+// Apply the process-wide search options to the session's engine
+static void applySearchOptions(GameSession* session) {
+    AI& ai = session->ai;
+    ai.setParallelMode(aiParallelMode);
+    ai.setEvalMode(aiEvalMode);
+    ai.setSearchAlgorithm(aiSearchAlgorithm);
+    ai.setOpeningBook(&openingBook);
+}
+
+// Search in the caller's thread. An async search still running reads the
+// engine's settings, so it is ended before they change.
+static Move searchAIMove(GameSession* session, int depth, int timeLimitMs) {
+    session->endSearch(true);
+    applySearchOptions(session);
+    session->ai.setDepth(depth);
+    session->ai.setTimeLimit(timeLimitMs);
+    return session->ai.getBestMove(session->game.getBoard());
+}
 
 // Internal helper to convert CellState to int
 int cellStateToInt(CellState state) {
@@ -14,22 +138,27 @@ int cellStateToInt(CellState state) {
     }
 }
 
-// Create a new game instance
+// Create a new game instance with its own engine
 void* createGame() {
-    return new Game();
+    return new GameSession();
 }
 
 // Delete a game instance
 void deleteGame(void* game) {
     if (game) {
-        delete static_cast<Game*>(game);
+        delete sessionOf(game);
     }
 }
 
-// Initialize the game
+// Initialize the game (the engine keeps its state; positions stay valid)
 void initializeGame(void* game) {
     if (game) {
-        static_cast<Game*>(game)->initialize();
+        GameSession* session = sessionOf(game);
+        session->endSearch(true);
+        session->hasSearchResult = false;
+        session->ai.stopPonder();
+        session->game.initialize();
+        session->publishState();
     }
 }
 
@@ -37,7 +166,7 @@ void initializeGame(void* game) {
 void getGameState(void* game, GameState* state) {
     if (!game || !state) return;
 
-    Game* g = static_cast<Game*>(game);
+    Game* g = &sessionOf(game)->game;
     const Board& board = g->getBoard();
 
     // Copy board state (flattened to 1D array)
@@ -63,11 +192,18 @@ void getGameState(void* game, GameState* state) {
     state->winner = (g->getWinner() == Player::PLAYER1) ? 1 : 2;
 }
 
+// State block of the game
+const StateBlock* getStateBlock(void* game) {
+    if (!game) return nullptr;
+    return &sessionOf(game)->stateBlock;
+}
+
 // Make a move
 int makeMove(void* game, MoveData* moveData) {
     if (!game || !moveData) return 0;
 
-    Game* g = static_cast<Game*>(game);
+    GameSession* session = sessionOf(game);
+    Game* g = &session->game;
 
     Move move(
         Position(moveData->fromRow, moveData->fromCol),
@@ -75,56 +211,288 @@ int makeMove(void* game, MoveData* moveData) {
         Position(moveData->removeRow, moveData->removeCol)
     );
 
-    return g->makeMove(move) ? 1 : 0;
+    if (!g->makeMove(move)) {
+        return 0;
+    }
+    session->publishState();
+
+    // A search of the previous position is of no use any more
+    session->endSearch(true);
+    session->hasSearchResult = false;
+
+    // The opponent's move decides whether the background search is reused
+    AI& ai = session->ai;
+    if (ai.isPondering()) {
+        ai.resolvePonder(g->getBoard());
+    }
+    return 1;
+}
+
+// Copy an engine move into the FFI structure (returns 0 if no move)
+static int fillMoveData(const Move& move, MoveData* moveData) {
+    if (!move.isValid()) {
+        return 0;
+    }
+
+    moveData->fromRow = move.from.row;
+    moveData->fromCol = move.from.col;
+    moveData->toRow = move.to.row;
+    moveData->toCol = move.to.col;
+    moveData->removeRow = move.removeCell.row;
+    moveData->removeCol = move.removeCell.col;
+
+    return 1;
 }
 
-// Get AI's best move
+// Get AI's best move with the session's depth and time settings
 int getAIMove(void* game, MoveData* moveData) {
     if (!game || !moveData) return 0;
 
-    Game* g = static_cast<Game*>(game);
-    AI ai(Player::PLAYER1, 2); // Depth 2 for fast performance
+    GameSession* session = sessionOf(game);
+    return fillMoveData(searchAIMove(session, session->depth, session->timeLimitMs), moveData);
+}
+
+// Get AI's best move within a time budget (iterative deepening)
+int getAIMoveTimed(void* game, int timeLimitMs, MoveData* moveData) {
+    if (!game || !moveData) return 0;
+
+    GameSession* session = sessionOf(game);
+    return fillMoveData(searchAIMove(session, MAX_SEARCH_DEPTH, timeLimitMs > 0 ? timeLimitMs : 1), moveData);
+}
+
+// Configure the game's engine; the table is only rebuilt if its size changes
+void configureEngine(void* game, int depth, int timeLimitMs, int hashSizeMB, int threads) {
+    if (!game) return;
+
+    GameSession* session = sessionOf(game);
+    session->endSearch(true);
+    session->depth = std::max(1, std::min(depth, MAX_SEARCH_DEPTH - 1));
+    session->timeLimitMs = std::max(0, timeLimitMs);
 
-    Move bestMove = ai.getBestMove(g->getBoard());
+    hashSizeMB = std::max(0, hashSizeMB);
+    if (hashSizeMB != session->hashSizeMB) {
+        session->ai.setHashSize(hashSizeMB);
+        session->hashSizeMB = hashSizeMB;
+    }
 
-    if (!bestMove.isValid()) {
+    threads = std::max(1, std::min(threads, MAX_THREADS));
+    if (threads != session->ai.getThreads()) {
+        session->ai.setThreads(threads);
+    }
+}
+
+// Forget everything the game's engine learned in earlier searches
+void clearEngineState(void* game) {
+    if (game) {
+        sessionOf(game)->endSearch(true);
+        sessionOf(game)->ai.clearHash();
+    }
+}
+
+// Ponder on the human's turn, right after the AI's move
+int startPonder(void* game) {
+    if (!game) return 0;
+
+    GameSession* session = sessionOf(game);
+    if (session->game.isGameOver() || session->game.getCurrentPlayer() != Player::PLAYER2) {
+        return 0;
+    }
+    session->endSearch(true);
+    return session->ai.startPonder(session->game.getBoard()) ? 1 : 0;
+}
+
+// Abandon pondering
+void stopPonder(void* game) {
+    if (game) {
+        sessionOf(game)->endSearch(true);
+        sessionOf(game)->ai.stopPonder();
+    }
+}
+
+// Start an AI search in an engine thread and return at once
+int startAISearch(void* game, int depth, int timeLimitMs) {
+    if (!game) return 0;
+
+    GameSession* session = sessionOf(game);
+    if (session->searchThread.joinable() || session->game.isGameOver() ||
+        session->game.getCurrentPlayer() != Player::PLAYER1) {
         return 0;
     }
 
-    moveData->fromRow = bestMove.from.row;
-    moveData->fromCol = bestMove.from.col;
-    moveData->toRow = bestMove.to.row;
-    moveData->toCol = bestMove.to.col;
-    moveData->removeRow = bestMove.removeCell.row;
-    moveData->removeCol = bestMove.removeCell.col;
+    applySearchOptions(session);
+    session->ai.setDepth(depth > 0 ? depth : MAX_SEARCH_DEPTH);
+    session->ai.setTimeLimit(std::max(0, timeLimitMs));
+
+    session->searchDone = false;
+    session->hasSearchResult = false;
+    Board board = session->game.getBoard();
+    session->searchThread = std::thread([session, board]() {
+        session->searchResult = session->ai.getBestMove(board);
+        session->searchDone = true;
+    });
+    return 1;
+}
+
+// Progress of the search while it runs, its result once it has finished
+int pollAISearch(void* game, AISearchStatus* status) {
+    if (!game || !status) return -1;
+
+    GameSession* session = sessionOf(game);
+    if (session->searchThread.joinable()) {
+        if (!session->searchDone) {
+            SearchProgress progress = session->ai.getProgress();
+            status->depth = progress.depth;
+            status->score = progress.score;
+            status->nodes = progress.nodes;
+            status->hasMove = fillMoveData(progress.bestMove, &status->move);
+            return 1;
+        }
+        session->endSearch(false);
+        session->hasSearchResult = true;
+    }
+    if (!session->hasSearchResult) {
+        return -1;
+    }
+
+    const AI& ai = session->ai;
+    status->depth = ai.getCompletedDepth();
+    status->score = ai.getLastScore();
+    status->nodes = ai.getNodesEvaluated();
+    status->hasMove = fillMoveData(session->searchResult, &status->move);
+    return 0;
+}
+
+// Stop the search early; its best move so far becomes the result
+void cancelAISearch(void* game) {
+    if (!game) return;
+
+    GameSession* session = sessionOf(game);
+    if (session->searchThread.joinable()) {
+        session->endSearch(true);
+        session->hasSearchResult = true;
+    }
+}
+
+// Ponder hits and misses of the game's engine
+void getPonderStats(void* game, int* hits, int* misses) {
+    if (!game) return;
+
+    const AI& ai = sessionOf(game)->ai;
+    if (hits) *hits = static_cast<int>(ai.getPonderHits());
+    if (misses) *misses = static_cast<int>(ai.getPonderMisses());
+}
+
+// Statistics of the engine's last finished search
+int getLastSearchStats(void* game, SearchStatsData* stats) {
+    if (!game || !stats) return 0;
+
+    SearchStats last = sessionOf(game)->ai.getLastSearchStats();
+    stats->nodes = last.nodes;
+    stats->leafEvals = last.leafEvals;
+    stats->betaCutoffs = last.betaCutoffs;
+    stats->firstMoveCutoffs = last.firstMoveCutoffs;
+    stats->firstMoveCutoffRate = last.firstMoveCutoffRate();
+    stats->hashProbes = last.hashProbes;
+    stats->hashHits = last.hashHits;
+    stats->effectiveBranchingFactor = last.effectiveBranchingFactor();
+    stats->completedDepth = last.completedDepth;
+    stats->maxPly = last.maxPly;
+    stats->timeMs = last.timeMs;
+    stats->fromBook = last.fromBook ? 1 : 0;
+    stats->iterationCount = last.iterationCount;
+    for (int i = 0; i < last.iterationCount; i++) {
+        stats->iterations[i].depth = last.iterations[i].depth;
+        stats->iterations[i].score = last.iterations[i].score;
+        stats->iterations[i].nodes = last.iterations[i].nodes;
+        stats->iterations[i].timeMs = last.iterations[i].timeMs;
+    }
+    return (last.nodes > 0 || last.fromBook) ? 1 : 0;
+}
+
+// Append the statistics of every search to a JSON-lines file
+int setSearchStatsLog(void* game, const char* path) {
+    if (!game) return 0;
 
+    GameSession* session = sessionOf(game);
+    session->endSearch(true);
+    session->ai.setStatsLog(nullptr);
+    if (session->statsFile.is_open()) {
+        session->statsFile.close();
+    }
+    if (!path || !*path) {
+        return 1;
+    }
+
+    session->statsFile.clear();
+    session->statsFile.open(path, std::ios::app);
+    if (!session->statsFile) {
+        return 0;
+    }
+    session->ai.setStatsLog(&session->statsFile);
     return 1;
 }
 
 // Check if game is over
 int isGameOver(void* game) {
     if (!game) return 0;
-    return static_cast<Game*>(game)->isGameOver() ? 1 : 0;
+    return sessionOf(game)->game.isGameOver() ? 1 : 0;
 }
 
 // Get winner
 int getWinner(void* game) {
     if (!game) return 0;
-    Game* g = static_cast<Game*>(game);
+    Game* g = &sessionOf(game)->game;
     return (g->getWinner() == Player::PLAYER1) ? 1 : 2;
 }
 
 // Get current player
 int getCurrentPlayer(void* game) {
     if (!game) return 0;
-    Game* g = static_cast<Game*>(game);
+    Game* g = &sessionOf(game)->game;
     return (g->getCurrentPlayer() == Player::PLAYER1) ? 1 : 2;
 }
 
 // Check if a player can move
 int canPlayerMove(void* game, int player) {
     if (!game) return 0;
-    Game* g = static_cast<Game*>(game);
+    Game* g = &sessionOf(game)->game;
     Player p = (player == 1) ? Player::PLAYER1 : Player::PLAYER2;
     return g->getBoard().canPlayerMove(p) ? 1 : 0;
 }
+
+// Set transposition table size for games created afterwards
+void setAIHashSize(int megabytes) {
+    aiHashSizeMB = megabytes > 0 ? megabytes : 0;
+}
+
+// Set number of search threads for games created afterwards
+void setAIThreads(int threads) {
+    aiThreads = std::max(1, std::min(threads, MAX_THREADS));
+}
+
+// Select Lazy SMP or YBWC for multi-threaded AI searches
+void setAIParallelMode(int mode) {
+    aiParallelMode = (mode == 1) ? ParallelMode::YBWC : ParallelMode::LAZY_SMP;
+}
+
+// Select the leaf evaluation for AI searches
+void setAIEvalMode(int mode) {
+    aiEvalMode = (mode == 1) ? EvalMode::TERRITORY : EvalMode::MOBILITY;
+}
+
+// Select the tree search for AI searches
+void setAISearchAlgorithm(int algorithm) {
+    switch (algorithm) {
+        case 0: aiSearchAlgorithm = SearchAlgorithm::MINMAX; break;
+        case 2: aiSearchAlgorithm = SearchAlgorithm::MTDF; break;
+        default: aiSearchAlgorithm = SearchAlgorithm::NEGAMAX_PVS; break;
+    }
+}
+
+// Map an opening book file for AI searches; a no-op once a book is open
+int loadOpeningBook(const char* path) {
+    std::lock_guard<std::mutex> guard(openingBookLock);
+    if (openingBook.isOpen()) return 1;
+    if (!path) return 0;
+    return openingBook.open(path) ? 1 : 0;
+}
@@ -7,39 +7,95 @@ Board::Board() {
 }
 
 void Board::initialize() {
-    // Set all cells to empty
-    for (int i = 0; i < BOARD_SIZE; i++) {
-        for (int j = 0; j < BOARD_SIZE; j++) {
-            grid[i][j] = CellState::EMPTY;
-        }
-    }
+    // No cells removed yet
+    removedMask = 0;
 
     // Set initial player positions
-    player1Pos = PLAYER1_INITIAL;
-    player2Pos = PLAYER2_INITIAL;
+    player1Sq = squareOf(PLAYER1_INITIAL);
+    player2Sq = squareOf(PLAYER2_INITIAL);
+
+    updateWalkable();
+
+    // First player to move: side key not set
+    hashKey = computePositionKey();
+    mirrorKey = computeMirroredKey();
+}
 
-    grid[player1Pos.row][player1Pos.col] = CellState::PLAYER1;
-    grid[player2Pos.row][player2Pos.col] = CellState::PLAYER2;
+uint64_t Board::computePositionKey() const {
+    uint64_t key = ZOBRIST_PLAYER1[player1Sq] ^ ZOBRIST_PLAYER2[player2Sq];
+    Bitboard removed = removedMask;
+    while (removed) {
+        key ^= ZOBRIST_REMOVED[popLsb(removed)];
+    }
+    return key;
+}
+
+uint64_t Board::computeMirroredKey() const {
+    uint64_t key = ZOBRIST_PLAYER1_MIRRORED[player1Sq] ^ ZOBRIST_PLAYER2_MIRRORED[player2Sq];
+    Bitboard removed = removedMask;
+    while (removed) {
+        key ^= ZOBRIST_REMOVED_MIRRORED[popLsb(removed)];
+    }
+    return key;
 }
 
 CellState Board::getCellState(const Position& pos) const {
-    return grid[pos.row][pos.col];
+    return getCellState(pos.row, pos.col);
 }
 
 CellState Board::getCellState(int row, int col) const {
-    return grid[row][col];
+    int square = squareOf(row, col);
+    if (removedMask & squareBit(square)) {
+        return CellState::REMOVED;
+    }
+    if (square == player1Sq) {
+        return CellState::PLAYER1;
+    }
+    if (square == player2Sq) {
+        return CellState::PLAYER2;
+    }
+    return CellState::EMPTY;
 }
 
 void Board::setCellState(const Position& pos, CellState state) {
-    grid[pos.row][pos.col] = state;
+    setCellState(pos.row, pos.col, state);
 }
 
 void Board::setCellState(int row, int col, CellState state) {
-    grid[row][col] = state;
+    int square = squareOf(row, col);
+
+    // Swap the old position key for the new one, keeping the side to move
+    hashKey ^= computePositionKey();
+    mirrorKey ^= computeMirroredKey();
+    switch (state) {
+        case CellState::EMPTY:
+            removedMask &= ~squareBit(square);
+            break;
+        case CellState::PLAYER1:
+            removedMask &= ~squareBit(square);
+            player1Sq = square;
+            break;
+        case CellState::PLAYER2:
+            removedMask &= ~squareBit(square);
+            player2Sq = square;
+            break;
+        case CellState::REMOVED:
+            removedMask |= squareBit(square);
+            break;
+    }
+    updateWalkable();
+    hashKey ^= computePositionKey();
+    mirrorKey ^= computeMirroredKey();
+}
+
+void Board::setSideToMove(Player player) {
+    uint64_t side = (player == Player::PLAYER2) ? ZOBRIST_SIDE : 0;
+    hashKey = computePositionKey() ^ side;
+    mirrorKey = computeMirroredKey() ^ side;
 }
 
 Position Board::getPlayerPosition(Player player) const {
-    return (player == Player::PLAYER1) ? player1Pos : player2Pos;
+    return positionOf(getPlayerSquare(player));
 }
 
 bool Board::isValidPosition(const Position& pos) const {
@@ -51,23 +107,16 @@ bool Board::isWalkable(const Position& pos) const {
     if (!isValidPosition(pos)) {
         return false;
     }
-    CellState state = getCellState(pos);
-    return state == CellState::EMPTY;
+    return (walkableMask & squareBit(squareOf(pos))) != 0;
 }
 
 std::vector<Position> Board::getValidNeighbors(const Position& pos) const {
     std::vector<Position> neighbors;
 
-    // 8 directions: up, down, left, right, and 4 diagonals
-    int dRow[] = {-1, -1, -1,  0,  0,  1,  1,  1};
-    int dCol[] = {-1,  0,  1, -1,  1, -1,  0,  1};
-
-    for (int i = 0; i < 8; i++) {
-        Position newPos(pos.row + dRow[i], pos.col + dCol[i]);
-
-        if (isValidPosition(newPos) && isWalkable(newPos)) {
-            neighbors.push_back(newPos);
-        }
+    // Walkable cells among the 8 neighbors, in raster order
+    Bitboard targets = NEIGHBOR_MASKS[squareOf(pos)] & walkableMask;
+    while (targets) {
+        neighbors.push_back(positionOf(popLsb(targets)));
     }
 
     return neighbors;
@@ -85,16 +134,9 @@ bool Board::isValidMove(const Move& move, Player player) const {
         return false;
     }
 
-    // Check if 'to' position is a valid neighbor
-    std::vector<Position> validNeighbors = getValidNeighbors(currentPos);
-    bool toIsValid = false;
-    for (const auto& neighbor : validNeighbors) {
-        if (neighbor == move.to) {
-            toIsValid = true;
-            break;
-        }
-    }
-    if (!toIsValid) {
+    // Check if 'to' position is a walkable neighbor
+    if (!isValidPosition(move.to) ||
+        !(getMoveTargets(player) & squareBit(squareOf(move.to)))) {
         return false;
     }
 
@@ -103,26 +145,14 @@ bool Board::isValidMove(const Move& move, Player player) const {
         return false;
     }
 
-    // Cannot remove a cell that's already removed
-    if (getCellState(move.removeCell) == CellState::REMOVED) {
-        return false;
-    }
-
-    // Cannot remove a cell with a piece on it
-    // After moving, check if removeCell has a piece
-    if (move.removeCell == move.to) {
-        return false; // Can't remove the cell we just moved to
-    }
+    // Cannot remove a cell that's already removed, the cell we just
+    // moved to, or the opponent's cell
+    Player opponent = (player == Player::PLAYER1) ? Player::PLAYER2 : Player::PLAYER1;
+    Bitboard removable = FULL_BOARD & ~removedMask
+                       & ~squareBit(squareOf(move.to))
+                       & ~squareBit(getPlayerSquare(opponent));
 
-    // Check if removeCell has opponent's piece
-    Position opponentPos = getPlayerPosition(
-        player == Player::PLAYER1 ? Player::PLAYER2 : Player::PLAYER1
-    );
-    if (move.removeCell == opponentPos) {
-        return false; // Can't remove opponent's cell
-    }
-
-    return true;
+    return (removable & squareBit(squareOf(move.removeCell))) != 0;
 }
 
 bool Board::applyMove(const Move& move, Player player) {
@@ -131,73 +161,94 @@ bool Board::applyMove(const Move& move, Player player) {
     }
 
     // Update player position
-    setCellState(move.from, CellState::EMPTY);
-    setCellState(move.to, player == Player::PLAYER1 ? CellState::PLAYER1 : CellState::PLAYER2);
-
+    int toSq = squareOf(move.to);
+    int removeSq = squareOf(move.removeCell);
     if (player == Player::PLAYER1) {
-        player1Pos = move.to;
+        hashKey ^= ZOBRIST_PLAYER1[player1Sq] ^ ZOBRIST_PLAYER1[toSq];
+        mirrorKey ^= ZOBRIST_PLAYER1_MIRRORED[player1Sq] ^ ZOBRIST_PLAYER1_MIRRORED[toSq];
+        player1Sq = toSq;
     } else {
-        player2Pos = move.to;
+        hashKey ^= ZOBRIST_PLAYER2[player2Sq] ^ ZOBRIST_PLAYER2[toSq];
+        mirrorKey ^= ZOBRIST_PLAYER2_MIRRORED[player2Sq] ^ ZOBRIST_PLAYER2_MIRRORED[toSq];
+        player2Sq = toSq;
     }
 
     // Remove the specified cell
-    setCellState(move.removeCell, CellState::REMOVED);
+    removedMask |= squareBit(removeSq);
+    hashKey ^= ZOBRIST_REMOVED[removeSq] ^ ZOBRIST_SIDE;
+    mirrorKey ^= ZOBRIST_REMOVED_MIRRORED[removeSq] ^ ZOBRIST_SIDE;
+
+    updateWalkable();
 
     return true;
 }
 
-std::vector<Move> Board::getAllPossibleMoves(Player player) const {
-    std::vector<Move> possibleMoves;
+void Board::makeMove(const Move& move, Player player, UndoInfo& undo) {
+    int& playerSq = (player == Player::PLAYER1) ? player1Sq : player2Sq;
+    int toSq = squareOf(move.to);
+    int removeSq = squareOf(move.removeCell);
 
-    Position currentPos = getPlayerPosition(player);
-    std::vector<Position> validNeighbors = getValidNeighbors(currentPos);
-
-    // For each valid neighbor position
-    for (const auto& toPos : validNeighbors) {
-        // For each cell on the board, check if it can be removed
-        for (int row = 0; row < BOARD_SIZE; row++) {
-            for (int col = 0; col < BOARD_SIZE; col++) {
-                Position removePos(row, col);
-
-                // Skip if cell is already removed
-                if (getCellState(removePos) == CellState::REMOVED) {
-                    continue;
-                }
-
-                // Skip if cell is the target position
-                if (removePos == toPos) {
-                    continue;
-                }
-
-                // Skip if cell is opponent's position
-                Player opponent = (player == Player::PLAYER1) ? Player::PLAYER2 : Player::PLAYER1;
-                Position opponentPos = getPlayerPosition(opponent);
-                if (removePos == opponentPos) {
-                    continue;
-                }
-
-                // This is a valid move
-                Move move(currentPos, toPos, removePos);
-                possibleMoves.push_back(move);
-            }
-        }
-    }
+    undo.fromSq = static_cast<int8_t>(playerSq);
+    undo.removedSq = static_cast<int8_t>(removeSq);
+
+    // The vacated square becomes walkable, the target and removed cell do not
+    walkableMask |= squareBit(playerSq);
+    walkableMask &= ~(squareBit(toSq) | squareBit(removeSq));
+    removedMask |= squareBit(removeSq);
+
+    const auto& pieceKeys = (player == Player::PLAYER1) ? ZOBRIST_PLAYER1 : ZOBRIST_PLAYER2;
+    hashKey ^= pieceKeys[playerSq] ^ pieceKeys[toSq] ^ ZOBRIST_REMOVED[removeSq] ^ ZOBRIST_SIDE;
+    const auto& mirroredKeys = (player == Player::PLAYER1) ? ZOBRIST_PLAYER1_MIRRORED : ZOBRIST_PLAYER2_MIRRORED;
+    mirrorKey ^= mirroredKeys[playerSq] ^ mirroredKeys[toSq] ^ ZOBRIST_REMOVED_MIRRORED[removeSq] ^ ZOBRIST_SIDE;
+
+    playerSq = toSq;
+}
 
-    return possibleMoves;
+void Board::unmakeMove(Player player, const UndoInfo& undo) {
+    int& playerSq = (player == Player::PLAYER1) ? player1Sq : player2Sq;
+
+    const auto& pieceKeys = (player == Player::PLAYER1) ? ZOBRIST_PLAYER1 : ZOBRIST_PLAYER2;
+    hashKey ^= pieceKeys[playerSq] ^ pieceKeys[undo.fromSq] ^ ZOBRIST_REMOVED[undo.removedSq] ^ ZOBRIST_SIDE;
+    const auto& mirroredKeys = (player == Player::PLAYER1) ? ZOBRIST_PLAYER1_MIRRORED : ZOBRIST_PLAYER2_MIRRORED;
+    mirrorKey ^= mirroredKeys[playerSq] ^ mirroredKeys[undo.fromSq] ^ ZOBRIST_REMOVED_MIRRORED[undo.removedSq]
+               ^ ZOBRIST_SIDE;
+
+    removedMask &= ~squareBit(undo.removedSq);
+    walkableMask |= squareBit(undo.removedSq) | squareBit(playerSq);
+    playerSq = undo.fromSq;
+    walkableMask &= ~squareBit(playerSq);
+}
+
+std::vector<Move> Board::getAllPossibleMoves(Player player) const {
+    MoveList moves;
+    generateMoves(player, moves);
+    return std::vector<Move>(moves.begin(), moves.end());
+}
+
+void Board::generateMoves(Player player, MoveList& moves) const {
+    moves.clear();
+    forEachMove(player, [&moves](const Move& move) {
+        moves.push_back(move);
+        return true;
+    });
 }
 
 bool Board::canPlayerMove(Player player) const {
-    Position currentPos = getPlayerPosition(player);
-    std::vector<Position> validNeighbors = getValidNeighbors(currentPos);
-    return !validNeighbors.empty();
+    return getMoveTargets(player) != 0;
 }
 
 Board Board::copy() const {
-    Board newBoard;
-    newBoard.grid = this->grid;
-    newBoard.player1Pos = this->player1Pos;
-    newBoard.player2Pos = this->player2Pos;
-    return newBoard;
+    return *this;
+}
+
+std::array<std::array<CellState, BOARD_SIZE>, BOARD_SIZE> Board::getGrid() const {
+    std::array<std::array<CellState, BOARD_SIZE>, BOARD_SIZE> grid;
+    for (int row = 0; row < BOARD_SIZE; row++) {
+        for (int col = 0; col < BOARD_SIZE; col++) {
+            grid[row][col] = getCellState(row, col);
+        }
+    }
+    return grid;
 }
 
 void Board::display() const {
@@ -210,7 +261,7 @@ void Board::display() const {
     for (int row = 0; row < BOARD_SIZE; row++) {
         std::cout << "  " << char('a' + row) << " ";
         for (int col = 0; col < BOARD_SIZE; col++) {
-            CellState state = grid[row][col];
+            CellState state = getCellState(row, col);
             switch (state) {
                 case CellState::EMPTY:
                     std::cout << "[ ]";
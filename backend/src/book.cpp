@@ -0,0 +1,145 @@
+#include "../include/book.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+const char BOOK_MAGIC[8] = {'S', 'G', 'B', 'O', 'O', 'K', '\0', '\0'};
+
+} // namespace
+
+bool writeOpeningBook(const char* path, std::vector<BookEntry> entries) {
+    std::sort(entries.begin(), entries.end(),
+              [](const BookEntry& a, const BookEntry& b) { return a.key < b.key; });
+
+    // One record per position
+    entries.erase(std::unique(entries.begin(), entries.end(),
+                              [](const BookEntry& a, const BookEntry& b) { return a.key == b.key; }),
+                  entries.end());
+
+    BookHeader header;
+    std::memcpy(header.magic, BOOK_MAGIC, sizeof(header.magic));
+    header.version = BOOK_VERSION;
+    header.count = static_cast<uint32_t>(entries.size());
+
+    FILE* file = std::fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(entries.data(), sizeof(BookEntry), entries.size(), file) == entries.size();
+    return (std::fclose(file) == 0) && ok;
+}
+
+OpeningBook::OpeningBook()
+    : entries(nullptr), count(0), view(nullptr), viewSize(0),
+      fileHandle(nullptr), mappingHandle(nullptr) {}
+
+OpeningBook::~OpeningBook() {
+    close();
+}
+
+bool OpeningBook::open(const char* path) {
+    close();
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart < static_cast<LONGLONG>(sizeof(BookHeader))) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    view = data;
+    viewSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(BookHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);    // The mapping stays valid after the descriptor is closed
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    view = data;
+    viewSize = static_cast<size_t>(info.st_size);
+#endif
+
+    // Validate the header and the record count against the file size
+    const BookHeader* header = static_cast<const BookHeader*>(view);
+    if (std::memcmp(header->magic, BOOK_MAGIC, sizeof(BOOK_MAGIC)) != 0 ||
+        header->version != BOOK_VERSION ||
+        sizeof(BookHeader) + static_cast<size_t>(header->count) * sizeof(BookEntry) > viewSize) {
+        close();
+        return false;
+    }
+
+    entries = reinterpret_cast<const BookEntry*>(static_cast<const char*>(view) + sizeof(BookHeader));
+    count = header->count;
+    return true;
+}
+
+void OpeningBook::close() {
+    if (view) {
+#if defined(_WIN32)
+        UnmapViewOfFile(view);
+        CloseHandle(static_cast<HANDLE>(mappingHandle));
+        CloseHandle(static_cast<HANDLE>(fileHandle));
+#else
+        munmap(const_cast<void*>(view), viewSize);
+#endif
+    }
+    entries = nullptr;
+    count = 0;
+    view = nullptr;
+    viewSize = 0;
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+}
+
+bool OpeningBook::probe(uint64_t key, BookEntry& entry) const {
+    if (!entries) {
+        return false;
+    }
+    const BookEntry* end = entries + count;
+    const BookEntry* found = std::lower_bound(entries, end, key,
+                                              [](const BookEntry& e, uint64_t k) { return e.key < k; });
+    if (found == end || found->key != key) {
+        return false;
+    }
+    entry = *found;
+    return true;
+}
@@ -0,0 +1,143 @@
+#include "../include/endgame.h"
+#include <initializer_list>
+
+namespace {
+
+constexpr uint64_t RESULT_BIT = uint64_t(1) << 62;
+constexpr uint64_t USED_BIT = uint64_t(1) << 63;
+
+// Area reachable from a piece over passable cells, the piece's square excluded
+Bitboard reachableFrom(int square, Bitboard passable) {
+    return floodFill(squareBit(square), passable) & ~squareBit(square);
+}
+
+// Area, square and neutral count packed into one memo word
+uint64_t memoWord(Bitboard area, int square, int neutral) {
+    return area | (static_cast<uint64_t>(square) << NUM_SQUARES)
+         | (static_cast<uint64_t>(neutral) << (NUM_SQUARES + 6));
+}
+
+size_t tableIndex(uint64_t mover, uint64_t other) {
+    uint64_t h = (mover ^ (other * 0x9E3779B97F4A7C15ULL)) * 0xBF58476D1CE4E5B9ULL;
+    return static_cast<size_t>(h >> 32) & (ENDGAME_TABLE_SIZE - 1);
+}
+
+} // namespace
+
+bool findSeparation(const Board& board, Separation& separation) {
+    Bitboard walkable = board.getWalkableMask();
+    Bitboard piece2 = squareBit(board.getPlayerSquare(Player::PLAYER2));
+
+    // Grow the first area one ring at a time; touching the second piece
+    // means its square (or the cells behind it) can still be shared
+    Bitboard area = squareBit(board.getPlayerSquare(Player::PLAYER1));
+    while (true) {
+        Bitboard ring = dilate(area);
+        if (ring & piece2) {
+            return false;
+        }
+        Bitboard grown = area | (ring & walkable);
+        if (grown == area) {
+            break;
+        }
+        area = grown;
+    }
+
+    // The first area is closed under walkable neighbors and not next to the
+    // second piece, so the second area cannot touch it either
+    separation.area1 = area;
+    separation.area2 = floodFill(piece2, walkable);
+    return true;
+}
+
+EndgameSolver::EndgameSolver()
+    : table(std::make_unique<Entry[]>(ENDGAME_TABLE_SIZE)) {}
+
+void EndgameSolver::clear() {
+    for (int i = 0; i < ENDGAME_TABLE_SIZE; i++) {
+        table[i] = Entry{0, 0};
+    }
+}
+
+bool EndgameSolver::probe(const Board& board, Player toMove, bool& toMoveWins) {
+    if (popCount(board.getRemovedMask()) < ENDGAME_MIN_REMOVED) {
+        return false;
+    }
+
+    Separation separation;
+    if (!findSeparation(board, separation)) {
+        return false;
+    }
+    if (popCount(separation.area1) + popCount(separation.area2) > ENDGAME_MAX_CELLS) {
+        return false;
+    }
+
+    Player opponent = (toMove == Player::PLAYER1) ? Player::PLAYER2 : Player::PLAYER1;
+    int mySq = board.getPlayerSquare(toMove);
+    int oppSq = board.getPlayerSquare(opponent);
+    Bitboard myArea = (toMove == Player::PLAYER1) ? separation.area1 : separation.area2;
+    Bitboard oppArea = (toMove == Player::PLAYER1) ? separation.area2 : separation.area1;
+    int neutral = popCount(board.getWalkableMask() & ~separation.area1 & ~separation.area2);
+
+    toMoveWins = solve(myArea & ~squareBit(mySq), mySq, oppArea & ~squareBit(oppSq), oppSq, neutral);
+    return true;
+}
+
+bool EndgameSolver::solve(Bitboard myArea, int mySq, Bitboard oppArea, int oppSq, int neutral) {
+    Bitboard targets = NEIGHBOR_MASKS[mySq] & myArea;
+    if (!targets) {
+        return false;
+    }
+
+    // A position and its mirror image share one memo entry
+    uint64_t mover = memoWord(myArea, mySq, neutral);
+    uint64_t other = memoWord(oppArea, oppSq, 0) | USED_BIT;
+    uint64_t mirroredMover = memoWord(mirror(myArea), mirrorSquare(mySq), neutral);
+    uint64_t mirroredOther = memoWord(mirror(oppArea), mirrorSquare(oppSq), 0) | USED_BIT;
+    if (mirroredMover < mover || (mirroredMover == mover && mirroredOther < other)) {
+        mover = mirroredMover;
+        other = mirroredOther;
+    }
+    Entry& entry = table[tableIndex(mover, other)];
+    if (entry.mover == mover && (entry.other & ~RESULT_BIT) == other) {
+        return (entry.other & RESULT_BIT) != 0;
+    }
+
+    bool win = false;
+    while (targets && !win) {
+        int toSq = popLsb(targets);
+
+        // The vacated square stays reachable from the new one
+        Bitboard area = (myArea & ~squareBit(toSq)) | squareBit(mySq);
+
+        if (oppArea) {
+            // Shrink the opponent's area, cells next to the opponent first;
+            // cells cut off by the removal become neutral
+            Bitboard near = oppArea & NEIGHBOR_MASKS[oppSq];
+            for (Bitboard removable : {near, oppArea & ~near}) {
+                while (removable && !win) {
+                    Bitboard rest = oppArea & ~squareBit(popLsb(removable));
+                    Bitboard oppAfter = reachableFrom(oppSq, rest);
+                    int cutOff = popCount(rest) - popCount(oppAfter);
+                    win = !solve(oppAfter, oppSq, area, toSq, neutral + cutOff);
+                }
+            }
+        } else if (neutral > 0) {
+            // Nothing of the opponent's left to remove: spend a neutral cell
+            win = !solve(oppArea, oppSq, area, toSq, neutral - 1);
+        } else {
+            // Forced to remove one of our own cells
+            Bitboard removable = area;
+            while (removable && !win) {
+                Bitboard rest = area & ~squareBit(popLsb(removable));
+                Bitboard mine = reachableFrom(toSq, rest);
+                int cutOff = popCount(rest) - popCount(mine);
+                win = !solve(oppArea, oppSq, mine, toSq, cutOff);
+            }
+        }
+    }
+
+    entry.mover = mover;
+    entry.other = other | (win ? RESULT_BIT : 0);
+    return win;
+}
@@ -1,5 +1,6 @@
 #include "../include/game.h"
 #include "../include/ai.h"
+#include "../include/protocol.h"
 #include <iostream>
 #include <sstream>
 #include <limits>
@@ -36,7 +37,12 @@ void displayHelp() {
     std::cout << "Type 'help' for this message, 'quit' to exit" << std::endl << std::endl;
 }
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Headless engine protocol for tools and scripts (see protocol.h)
+    if (argc > 1 && std::string(argv[1]) == "--protocol") {
+        return runProtocol(std::cin, std::cout);
+    }
+
     std::cout << "=== Strategic Board Game - AI Demo ===" << std::endl;
     std::cout << "Player 1 (Blue/AI) vs Player 2 (Red/Human)" << std::endl << std::endl;
 
@@ -0,0 +1,205 @@
+#include "../include/movepick.h"
+#include <utility>
+
+void OrderingTables::clear() {
+    for (auto& plyKillers : killers) {
+        for (auto& killer : plyKillers) {
+            killer = NO_MOVE;
+        }
+    }
+    for (auto& side : history) {
+        for (auto& row : side) {
+            for (auto& value : row) {
+                value = 0;
+            }
+        }
+    }
+}
+
+void OrderingTables::newSearch() {
+    for (auto& plyKillers : killers) {
+        for (auto& killer : plyKillers) {
+            killer = NO_MOVE;
+        }
+    }
+    for (auto& side : history) {
+        for (auto& row : side) {
+            for (auto& value : row) {
+                value /= 2;
+            }
+        }
+    }
+}
+
+void OrderingTables::recordCutoff(Player player, PackedMove move, int ply, int depth) {
+    // Killers: most recent first, no duplicates
+    if (ply < MAX_PLY && killers[ply][0] != move) {
+        for (int i = NUM_KILLERS - 1; i > 0; i--) {
+            killers[ply][i] = killers[ply][i - 1];
+        }
+        killers[ply][0] = move;
+    }
+
+    // History: deeper cutoffs count more
+    auto& side = history[player == Player::PLAYER1 ? 0 : 1];
+    int& value = side[move & 63][(move >> 6) & 63];
+    value += depth * depth;
+
+    if (value > HISTORY_MAX) {
+        for (auto& row : side) {
+            for (auto& entry : row) {
+                entry /= 2;
+            }
+        }
+    }
+}
+
+MovePicker::MovePicker(const Board& board, Player player, PackedMove hashMove,
+                       const OrderingTables& tables, int ply)
+    : board(board), player(player), from(board.getPlayerPosition(player)),
+      tables(tables), ply(ply), stage(Stage::HASH_MOVE),
+      searchedCount(0), killerIndex(0),
+      destinationCount(0), destinationIndex(0),
+      removalCount(0), removalIndex(0) {
+    Player opponent = (player == Player::PLAYER1) ? Player::PLAYER2 : Player::PLAYER1;
+    nearOpponent = NEIGHBOR_MASKS[board.getPlayerSquare(opponent)];
+    searched[0] = hashMove;
+}
+
+bool MovePicker::alreadySearched(PackedMove move) const {
+    for (int i = 0; i < searchedCount; i++) {
+        if (searched[i] == move) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void MovePicker::orderDestinations() {
+    int mobility[8];
+    Bitboard targets = board.getMoveTargets(player);
+    while (targets) {
+        int toSq = popLsb(targets);
+        int value = board.getMobilityAfterStep(player, toSq);
+
+        // Insertion sort, highest mobility first
+        int i = destinationCount++;
+        while (i > 0 && mobility[i - 1] < value) {
+            destinations[i] = destinations[i - 1];
+            mobility[i] = mobility[i - 1];
+            i--;
+        }
+        destinations[i] = toSq;
+        mobility[i] = value;
+    }
+}
+
+void MovePicker::loadRemovals(Bitboard mask) {
+    const auto& side = tables.history[player == Player::PLAYER1 ? 0 : 1];
+    int toSq = destinations[destinationIndex];
+
+    removalCount = 0;
+    removalIndex = 0;
+    while (mask) {
+        int removeSq = popLsb(mask);
+        removals[removalCount] = removeSq;
+        removalScores[removalCount] = side[toSq][removeSq];
+        removalCount++;
+    }
+}
+
+bool MovePicker::nextRemoval(Move& move, bool adjacent) {
+    while (true) {
+        // Selection sort step over the current destination's removals
+        while (removalIndex < removalCount) {
+            int best = removalIndex;
+            for (int i = removalIndex + 1; i < removalCount; i++) {
+                if (removalScores[i] > removalScores[best]) {
+                    best = i;
+                }
+            }
+            std::swap(removals[removalIndex], removals[best]);
+            std::swap(removalScores[removalIndex], removalScores[best]);
+
+            int toSq = destinations[destinationIndex];
+            int removeSq = removals[removalIndex++];
+            PackedMove packed = static_cast<PackedMove>(toSq | (removeSq << 6));
+            if (!alreadySearched(packed)) {
+                move = Move(from, positionOf(toSq), positionOf(removeSq));
+                return true;
+            }
+        }
+
+        // Current destination exhausted: generate the next one's removals
+        if (++destinationIndex >= destinationCount) {
+            return false;
+        }
+
+        int toSq = destinations[destinationIndex];
+        Bitboard removable = board.getRemovableMask(player, toSq);
+        loadRemovals(adjacent ? (removable & nearOpponent) : (removable & ~nearOpponent));
+    }
+}
+
+bool MovePicker::next(Move& move) {
+    switch (stage) {
+        case Stage::HASH_MOVE:
+            stage = Stage::KILLERS;
+            // Verify it since different positions may share a table entry
+            if (searched[0] != NO_MOVE) {
+                move = unpackMove(searched[0], from);
+                if (board.isValidMove(move, player)) {
+                    searchedCount = 1;
+                    return true;
+                }
+            }
+            [[fallthrough]];
+
+        case Stage::KILLERS:
+            // Killers come from sibling positions and may be illegal here
+            if (ply < MAX_PLY) {
+                while (killerIndex < NUM_KILLERS) {
+                    PackedMove killer = tables.killers[ply][killerIndex++];
+                    if (killer == NO_MOVE || alreadySearched(killer)) {
+                        continue;
+                    }
+                    move = unpackMove(killer, from);
+                    if (board.isValidMove(move, player)) {
+                        searched[searchedCount++] = killer;
+                        return true;
+                    }
+                }
+            }
+            stage = Stage::DESTINATIONS;
+            [[fallthrough]];
+
+        case Stage::DESTINATIONS:
+            orderDestinations();
+            destinationIndex = -1;
+            removalCount = 0;
+            removalIndex = 0;
+            stage = Stage::ADJACENT_REMOVALS;
+            [[fallthrough]];
+
+        case Stage::ADJACENT_REMOVALS:
+            if (nextRemoval(move, true)) {
+                return true;
+            }
+            destinationIndex = -1;
+            removalCount = 0;
+            removalIndex = 0;
+            stage = Stage::OTHER_REMOVALS;
+            [[fallthrough]];
+
+        case Stage::OTHER_REMOVALS:
+            if (nextRemoval(move, false)) {
+                return true;
+            }
+            stage = Stage::DONE;
+            [[fallthrough]];
+
+        case Stage::DONE:
+            break;
+    }
+    return false;
+}
@@ -0,0 +1,78 @@
+#include "../include/notation.h"
+#include <algorithm>
+
+std::string cellToString(const Position& pos) {
+    return std::string(1, static_cast<char>('a' + pos.row)) + static_cast<char>('1' + pos.col);
+}
+
+bool parseCell(const std::string& text, size_t offset, Position& pos) {
+    if (offset + 2 > text.size()) {
+        return false;
+    }
+    int row = text[offset] - 'a';
+    int col = text[offset + 1] - '1';
+    if (row < MIN_COORD || row > MAX_COORD || col < MIN_COORD || col > MAX_COORD) {
+        return false;
+    }
+    pos = Position(row, col);
+    return true;
+}
+
+std::string moveToString(const Move& move) {
+    return cellToString(move.from) + cellToString(move.to) + cellToString(move.removeCell);
+}
+
+bool parseMove(const std::string& text, Move& move) {
+    return text.size() == 6 && parseCell(text, 0, move.from) && parseCell(text, 2, move.to) &&
+           parseCell(text, 4, move.removeCell);
+}
+
+std::string positionToString(const Board& board) {
+    std::string text;
+    for (int row = MIN_COORD; row <= MAX_COORD; row++) {
+        if (row > MIN_COORD) {
+            text += '/';
+        }
+        for (int col = MIN_COORD; col <= MAX_COORD; col++) {
+            switch (board.getCellState(row, col)) {
+                case CellState::EMPTY: text += '.'; break;
+                case CellState::PLAYER1: text += '1'; break;
+                case CellState::PLAYER2: text += '2'; break;
+                case CellState::REMOVED: text += 'x'; break;
+            }
+        }
+    }
+    return text;
+}
+
+bool parsePosition(const std::string& text, Board& board) {
+    std::string cells;
+    for (char c : text) {
+        if (c != '/') {
+            cells += c;
+        }
+    }
+    if (static_cast<int>(cells.size()) != NUM_SQUARES ||
+        std::count(cells.begin(), cells.end(), '1') != 1 ||
+        std::count(cells.begin(), cells.end(), '2') != 1 ||
+        cells.find_first_not_of(".x12") != std::string::npos) {
+        return false;
+    }
+
+    // Pieces are placed last: placing one moves it off its previous square
+    Board result;
+    for (int sq = 0; sq < NUM_SQUARES; sq++) {
+        if (cells[sq] == 'x') {
+            result.setCellState(positionOf(sq), CellState::REMOVED);
+        }
+    }
+    for (int sq = 0; sq < NUM_SQUARES; sq++) {
+        if (cells[sq] == '1') {
+            result.setCellState(positionOf(sq), CellState::PLAYER1);
+        } else if (cells[sq] == '2') {
+            result.setCellState(positionOf(sq), CellState::PLAYER2);
+        }
+    }
+    board = result;
+    return true;
+}
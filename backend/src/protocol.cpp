@@ -0,0 +1,369 @@
+#include "../include/protocol.h"
+#include "../include/ai.h"
+#include "../include/notation.h"
+#include "../include/null_buffer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Default depth of "go" without limits
+const int DEFAULT_GO_DEPTH = 5;
+
+Player otherPlayer(Player player) {
+    return (player == Player::PLAYER1) ? Player::PLAYER2 : Player::PLAYER1;
+}
+
+// "cp <n>", or "mate <n>" for a won (negative: lost) game. A win scores
+// WIN_SCORE plus the depth left where it was settled, so it is n moves of
+// the engine away in a search of the given depth.
+std::string scoreToString(int score, int depth) {
+    if (std::abs(score) < WIN_SCORE - MAX_SEARCH_DEPTH) {
+        return "cp " + std::to_string(score);
+    }
+    int plies = std::max(1, depth - (std::abs(score) - WIN_SCORE));
+    int moves = (plies + 1) / 2;
+    return "mate " + std::to_string(score > 0 ? moves : -moves);
+}
+
+struct GoLimits {
+    int depth = 0;          // 0 = the Depth option (or no limit with other limits)
+    int moveTimeMs = 0;
+    long long nodes = 0;
+    bool infinite = false;
+};
+
+class ProtocolSession {
+private:
+    std::ostream& out;
+    std::mutex outputLock;
+
+    // Position set by the last "position" command
+    Board board;
+    Player side;
+
+    // Book used by the engines; declared first so it outlives them
+    OpeningBook book;
+
+    // One engine per side (an AI always searches for the same player)
+    std::unique_ptr<AI> engines[2];
+    int goDepth;
+
+    // Search started by "go"
+    std::thread searchThread;
+    AI* searchingEngine;
+
+    AI& engineFor(Player player) {
+        return *engines[player == Player::PLAYER1 ? 0 : 1];
+    }
+
+public:
+    explicit ProtocolSession(std::ostream& output)
+        : out(output), side(Player::PLAYER1), goDepth(DEFAULT_GO_DEPTH), searchingEngine(nullptr) {
+        engines[0] = std::make_unique<AI>(Player::PLAYER1, DEFAULT_GO_DEPTH);
+        engines[1] = std::make_unique<AI>(Player::PLAYER2, DEFAULT_GO_DEPTH);
+    }
+
+    ~ProtocolSession() {
+        stopSearch();
+    }
+
+    // Write one reply line; flushed so that pipe readers see it at once
+    void send(const std::string& line) {
+        std::lock_guard<std::mutex> guard(outputLock);
+        out << line << '\n' << std::flush;
+    }
+
+    // Stop the running search, if any, and wait for its bestmove
+    void stopSearch() {
+        if (!searchThread.joinable()) {
+            return;
+        }
+        searchingEngine->requestStop();
+        searchThread.join();
+        searchingEngine->clearStopRequest();
+        searchingEngine = nullptr;
+    }
+
+    void uci() {
+        send("id name Strategic Board Game");
+        send("option name Hash type spin default " + std::to_string(DEFAULT_HASH_MB) + " min 0 max 4096");
+        send("option name Threads type spin default 1 min 1 max " + std::to_string(MAX_THREADS));
+        send("option name Depth type spin default " + std::to_string(DEFAULT_GO_DEPTH) + " min 1 max " +
+             std::to_string(MAX_SEARCH_DEPTH - 1));
+        send("option name Eval type combo default mobility var mobility var territory");
+        send("option name Algorithm type combo default pvs var minmax var pvs var mtdf");
+        send("option name Parallel type combo default lazy var lazy var ybwc");
+        send("option name BookFile type string default <empty>");
+        send("uciok");
+    }
+
+    void newGame() {
+        stopSearch();
+        for (auto& engine : engines) {
+            engine->clearHash();
+        }
+        board = Board();
+        side = Player::PLAYER1;
+    }
+
+    void position(std::istringstream& args) {
+        stopSearch();
+        std::string token;
+        args >> token;
+
+        Board newBoard;
+        Player newSide = Player::PLAYER1;
+        if (token == "cells") {
+            std::string cells;
+            std::string sideText;
+            args >> cells >> sideText;
+            if ((sideText != "1" && sideText != "2") || !parsePosition(cells, newBoard)) {
+                send("info string invalid position");
+                return;
+            }
+            newSide = (sideText == "1") ? Player::PLAYER1 : Player::PLAYER2;
+            newBoard.setSideToMove(newSide);
+            args >> token;
+        } else if (token == "startpos") {
+            args >> token;
+        } else {
+            send("info string invalid position");
+            return;
+        }
+
+        // Moves are applied up to the first illegal one
+        if (token == "moves") {
+            while (args >> token) {
+                Move move;
+                if (!parseMove(token, move) || !(move.from == newBoard.getPlayerPosition(newSide)) ||
+                    !newBoard.applyMove(move, newSide)) {
+                    send("info string illegal move " + token);
+                    break;
+                }
+                newSide = otherPlayer(newSide);
+            }
+        }
+
+        board = newBoard;
+        side = newSide;
+    }
+
+    void setOption(std::istringstream& args) {
+        stopSearch();
+
+        // setoption name <Name> value <Value>
+        std::string token;
+        std::string name;
+        std::string value;
+        args >> token >> name >> token;
+        std::getline(args >> std::ws, value);
+
+        bool valid = true;
+        if (name == "Hash") {
+            for (auto& engine : engines) {
+                engine->setHashSize(std::max(0, std::atoi(value.c_str())));
+            }
+        } else if (name == "Threads") {
+            for (auto& engine : engines) {
+                engine->setThreads(std::atoi(value.c_str()));
+            }
+        } else if (name == "Depth") {
+            goDepth = std::max(1, std::min(std::atoi(value.c_str()), MAX_SEARCH_DEPTH - 1));
+        } else if (name == "Eval" && (value == "mobility" || value == "territory")) {
+            for (auto& engine : engines) {
+                engine->setEvalMode(value == "territory" ? EvalMode::TERRITORY : EvalMode::MOBILITY);
+            }
+        } else if (name == "Algorithm" && (value == "minmax" || value == "pvs" || value == "mtdf")) {
+            SearchAlgorithm algorithm = (value == "minmax") ? SearchAlgorithm::MINMAX :
+                                        (value == "mtdf") ? SearchAlgorithm::MTDF : SearchAlgorithm::NEGAMAX_PVS;
+            for (auto& engine : engines) {
+                engine->setSearchAlgorithm(algorithm);
+            }
+        } else if (name == "Parallel" && (value == "lazy" || value == "ybwc")) {
+            for (auto& engine : engines) {
+                engine->setParallelMode(value == "ybwc" ? ParallelMode::YBWC : ParallelMode::LAZY_SMP);
+            }
+        } else if (name == "BookFile") {
+            for (auto& engine : engines) {
+                engine->setOpeningBook(nullptr);
+            }
+            if (value.empty() || value == "<empty>") {
+                book.close();
+            } else if (book.open(value.c_str())) {
+                for (auto& engine : engines) {
+                    engine->setOpeningBook(&book);
+                }
+            } else {
+                send("info string cannot open book " + value);
+            }
+        } else {
+            valid = false;
+        }
+
+        if (!valid) {
+            send("info string invalid option " + name + " " + value);
+        }
+    }
+
+    void go(std::istringstream& args) {
+        stopSearch();
+
+        GoLimits limits;
+        std::string token;
+        while (args >> token) {
+            if (token == "depth") {
+                args >> limits.depth;
+            } else if (token == "movetime") {
+                args >> limits.moveTimeMs;
+            } else if (token == "nodes") {
+                args >> limits.nodes;
+            } else if (token == "infinite") {
+                limits.infinite = true;
+            }
+        }
+
+        if (!board.canPlayerMove(side)) {
+            send("bestmove none");
+            return;
+        }
+
+        // Any explicit limit other than depth lifts the default depth
+        int depth = limits.depth;
+        if (depth <= 0) {
+            depth = (limits.infinite || limits.moveTimeMs > 0 || limits.nodes > 0) ? MAX_SEARCH_DEPTH : goDepth;
+        }
+
+        AI& engine = engineFor(side);
+        engine.setDepth(depth);
+        engine.setTimeLimit(limits.infinite ? 0 : limits.moveTimeMs);
+        engine.setNodeLimit(limits.infinite ? 0 : limits.nodes);
+        searchingEngine = &engine;
+        searchThread = std::thread([this, &engine, position = board]() { runSearch(engine, position); });
+    }
+
+    // Search in a helper thread; report each completed iteration while it runs
+    void runSearch(AI& engine, Board position) {
+        auto start = std::chrono::steady_clock::now();
+        std::atomic<bool> done(false);
+        Move best;
+        std::thread worker([&]() {
+            best = engine.getBestMove(position);
+            done = true;
+        });
+
+        int reported = 0;
+        while (!done) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            SearchProgress progress = engine.getProgress();
+            if (progress.depth > reported) {
+                double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+                sendInfo(progress.depth, progress.score, progress.nodes, ms, &progress.bestMove);
+                reported = progress.depth;
+            }
+        }
+        worker.join();
+
+        // Iterations finished between two polls
+        SearchStats stats = engine.getLastSearchStats();
+        if (stats.fromBook) {
+            send("info string book move");
+        }
+        long long nodes = 0;
+        double ms = 0.0;
+        for (int i = 0; i < stats.iterationCount; i++) {
+            const IterationStats& iteration = stats.iterations[i];
+            nodes += iteration.nodes;
+            ms += iteration.timeMs;
+            if (iteration.depth > reported) {
+                bool last = (i + 1 == stats.iterationCount);
+                sendInfo(iteration.depth, iteration.score, nodes, ms, last ? &best : nullptr);
+            }
+        }
+
+        send("bestmove " + moveToString(best));
+    }
+
+    void sendInfo(int depth, int score, long long nodes, double ms, const Move* pv) {
+        std::ostringstream line;
+        line << "info depth " << depth << " score " << scoreToString(score, depth) << " nodes " << nodes << " time "
+             << static_cast<long long>(ms) << " nps " << static_cast<long long>(ms > 0 ? nodes * 1000.0 / ms : 0);
+        if (pv) {
+            line << " pv " << moveToString(*pv);
+        }
+        send(line.str());
+    }
+
+    void display() {
+        // Position string rows are BOARD_SIZE cells and a '/'
+        std::string cells = positionToString(board);
+        for (int row = MIN_COORD; row <= MAX_COORD; row++) {
+            std::string line(1, static_cast<char>('a' + row));
+            for (int col = MIN_COORD; col <= MAX_COORD; col++) {
+                line += ' ';
+                line += cells[row * (BOARD_SIZE + 1) + col];
+            }
+            send(line);
+        }
+        send("  1 2 3 4 5 6 7");
+        send("position cells " + cells + (side == Player::PLAYER1 ? " 1" : " 2"));
+    }
+};
+
+} // namespace
+
+int runProtocol(std::istream& in, std::ostream& out) {
+    // The search's console log would interleave with replies
+    std::ostream reply(out.rdbuf());
+    NullBuffer discard;
+    std::streambuf* saved = std::cout.rdbuf(&discard);
+
+    {
+        ProtocolSession session(reply);
+        std::string line;
+        while (std::getline(in, line)) {
+            std::istringstream args(line);
+            std::string command;
+            if (!(args >> command)) {
+                continue;
+            }
+
+            if (command == "uci") {
+                session.uci();
+            } else if (command == "isready") {
+                session.send("readyok");
+            } else if (command == "ucinewgame") {
+                session.newGame();
+            } else if (command == "position") {
+                session.position(args);
+            } else if (command == "go") {
+                session.go(args);
+            } else if (command == "stop") {
+                session.stopSearch();
+            } else if (command == "setoption") {
+                session.setOption(args);
+            } else if (command == "d") {
+                session.display();
+            } else if (command == "quit") {
+                break;
+            } else {
+                session.send("info string unknown command " + command);
+            }
+        }
+
+        // End of input is a quit: a "go infinite" search would never end
+        session.stopSearch();
+    }
+
+    std::cout.rdbuf(saved);
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include "../include/tt.h"
+
+namespace {
+
+// Data word layout: score (bits 0-31), move (32-47), depth (48-55), genBound (56-63)
+uint64_t packEntry(int score, PackedMove move, int depth, uint8_t genBound) {
+    return static_cast<uint64_t>(static_cast<uint32_t>(score))
+         | (static_cast<uint64_t>(move) << 32)
+         | (static_cast<uint64_t>(static_cast<uint8_t>(depth)) << 48)
+         | (static_cast<uint64_t>(genBound) << 56);
+}
+
+TTEntry unpackEntry(uint64_t key, uint64_t data) {
+    TTEntry entry;
+    entry.key = key;
+    entry.score = static_cast<int32_t>(static_cast<uint32_t>(data));
+    entry.move = static_cast<PackedMove>(data >> 32);
+    entry.depth = static_cast<int8_t>(static_cast<uint8_t>(data >> 48));
+    entry.genBound = static_cast<uint8_t>(data >> 56);
+    return entry;
+}
+
+} // namespace
+
+TranspositionTable::TranspositionTable(int sizeMB)
+    : bucketCount(0), indexMask(0), generation(0) {
+    resize(sizeMB);
+}
+
+void TranspositionTable::resize(int sizeMB) {
+    buckets.reset();
+    bucketCount = 0;
+    indexMask = 0;
+
+    if (sizeMB <= 0) {
+        return;
+    }
+
+    // Largest power of two not exceeding the requested size
+    uint64_t maxBuckets = (static_cast<uint64_t>(sizeMB) << 20) / sizeof(TTBucket);
+    uint64_t count = 1;
+    while (count * 2 <= maxBuckets) {
+        count *= 2;
+    }
+
+    buckets.reset(new TTBucket[count]);
+    bucketCount = count;
+    indexMask = count - 1;
+    clear();
+}
+
+void TranspositionTable::clear() {
+    for (uint64_t i = 0; i < bucketCount; i++) {
+        for (int slot = 0; slot < TT_BUCKET_SIZE; slot++) {
+            buckets[i].keyXorData[slot].store(0, std::memory_order_relaxed);
+            buckets[i].data[slot].store(0, std::memory_order_relaxed);
+        }
+    }
+    generation = 0;
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry& entry) const {
+    if (bucketCount == 0) {
+        return false;
+    }
+
+    const TTBucket& bucket = buckets[key & indexMask];
+    for (int slot = 0; slot < TT_BUCKET_SIZE; slot++) {
+        uint64_t data = bucket.data[slot].load(std::memory_order_relaxed);
+        uint64_t check = bucket.keyXorData[slot].load(std::memory_order_relaxed);
+        if ((check ^ data) == key && data != 0) {
+            entry = unpackEntry(key, data);
+            return entry.bound() != Bound::NONE;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, int score, Bound bound, int depth, PackedMove move) {
+    if (bucketCount == 0) {
+        return;
+    }
+
+    TTBucket& bucket = buckets[key & indexMask];
+
+    // Prefer the slot already holding this position, otherwise replace the
+    // entry with the lowest depth, treating entries from old searches as shallower
+    int replace = 0;
+    int worstValue = 1 << 30;
+    for (int slot = 0; slot < TT_BUCKET_SIZE; slot++) {
+        uint64_t data = bucket.data[slot].load(std::memory_order_relaxed);
+        uint64_t check = bucket.keyXorData[slot].load(std::memory_order_relaxed);
+        TTEntry candidate = unpackEntry(check ^ data, data);
+
+        if (candidate.key == key) {
+            // A deeper result of this search is worth more than a shallower
+            // bound (re-searches with other windows store those); only an
+            // exact score replaces it
+            if (candidate.generation() == generation && candidate.depth > depth &&
+                candidate.bound() != Bound::NONE && bound != Bound::EXACT) {
+                return;
+            }
+            replace = slot;
+            // Keep the old best move if this search did not find one
+            if (move == NO_MOVE) {
+                move = candidate.move;
+            }
+            break;
+        }
+        int age = (generation - candidate.generation()) & 63;
+        int value = candidate.depth - age * 4;
+        if (data == 0 || candidate.bound() == Bound::NONE) {
+            value = -(1 << 20);
+        }
+        if (value < worstValue) {
+            worstValue = value;
+            replace = slot;
+        }
+    }
+
+    uint8_t genBound = static_cast<uint8_t>((generation << 2) | static_cast<uint8_t>(bound));
+    uint64_t data = packEntry(score, move, depth, genBound);
+    bucket.data[replace].store(data, std::memory_order_relaxed);
+    bucket.keyXorData[replace].store(key ^ data, std::memory_order_relaxed);
+}
+
+int TranspositionTable::getSizeMB() const {
+    return static_cast<int>((bucketCount * sizeof(TTBucket)) >> 20);
+}
@@ -0,0 +1,49 @@
+#include "../include/ybwc.h"
+
+bool WorkDeque::push(SplitTask* task) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (back == WORK_DEQUE_CAPACITY) {
+        if (front == 0) {
+            return false;
+        }
+        // Reuse the slots freed by thieves at the front
+        for (int i = front; i < back; i++) {
+            tasks[i - front] = tasks[i];
+        }
+        back -= front;
+        front = 0;
+    }
+    tasks[back++] = task;
+    return true;
+}
+
+SplitTask* WorkDeque::popWithin(const SplitPoint* splitPoint) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (front == back || !tasks[back - 1]->splitPoint->isWithin(splitPoint)) {
+        return nullptr;
+    }
+    SplitTask* task = tasks[--back];
+    if (front == back) {
+        front = back = 0;
+    }
+    return task;
+}
+
+SplitTask* WorkDeque::steal(const SplitPoint* splitPoint) {
+    std::lock_guard<std::mutex> guard(lock);
+    for (int i = front; i < back; i++) {
+        if (!splitPoint || tasks[i]->splitPoint->isWithin(splitPoint)) {
+            SplitTask* task = tasks[i];
+            // Close the gap from the front side (usually i == front)
+            for (int j = i; j > front; j--) {
+                tasks[j] = tasks[j - 1];
+            }
+            front++;
+            if (front == back) {
+                front = back = 0;
+            }
+            return task;
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,80 @@
+#include "../include/board.h"
+#include "../include/ai.h"
+#include "../include/book.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+// Builds the opening book: deep searches over the opening tree from the
+// initial position. The first player (the AI in the app) gets its best
+// move stored; every reply of the second player is expanded.
+// Usage: book_gen <output file> [plies] [depth]
+
+namespace {
+
+struct BookBuilder {
+    AI ai;
+    int plies;
+    std::vector<BookEntry> entries;
+    std::unordered_set<uint64_t> visited;
+
+    BookBuilder(int depth, int bookPlies)
+        : ai(Player::PLAYER1, depth, 256, static_cast<int>(std::max(1u, std::thread::hardware_concurrency()))),
+          plies(bookPlies) {}
+
+    // Store the first player's move at this position and expand the replies to it
+    void expand(Board& board, int ply) {
+        // Mirror images share a canonical key and are stored once
+        if (ply >= plies || !visited.insert(board.getCanonicalHash()).second) {
+            return;
+        }
+
+        Move best = ai.getBestMove(board);
+        entries.push_back(BookEntry{board.getCanonicalHash(), board.orientMove(packMove(best)), 0,
+                                    ai.getLastScore()});
+        std::cerr << "ply " << ply << ": " << entries.size() << " positions" << std::endl;
+
+        if (ply + 2 >= plies) {
+            return;
+        }
+
+        UndoInfo undo;
+        board.makeMove(best, Player::PLAYER1, undo);
+        MoveList replies;
+        board.generateMoves(Player::PLAYER2, replies);
+        for (const auto& reply : replies) {
+            UndoInfo replyUndo;
+            board.makeMove(reply, Player::PLAYER2, replyUndo);
+            if (board.canPlayerMove(Player::PLAYER1)) {
+                expand(board, ply + 2);
+            }
+            board.unmakeMove(Player::PLAYER2, replyUndo);
+        }
+        board.unmakeMove(Player::PLAYER1, undo);
+    }
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: book_gen <output file> [plies] [depth]" << std::endl;
+        return 1;
+    }
+    int plies = (argc > 2) ? std::atoi(argv[2]) : 3;
+    int depth = (argc > 3) ? std::atoi(argv[3]) : 5;
+
+    BookBuilder builder(depth, plies);
+    Board board;
+    builder.expand(board, 0);
+
+    if (!writeOpeningBook(argv[1], builder.entries)) {
+        std::cerr << "Cannot write " << argv[1] << std::endl;
+        return 1;
+    }
+    std::cerr << "Wrote " << builder.entries.size() << " positions to " << argv[1] << std::endl;
+    return 0;
+}
@@ -0,0 +1,397 @@
+#include "../include/game.h"
+#include "../include/ai.h"
+#include "../include/null_buffer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <initializer_list>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Self-play match between two engine configurations (A and B).
+// Games run in parallel, one per worker thread, each with its own Game and
+// two AI instances. Every random opening is played twice with colors
+// swapped; results are counted per pair. Stops after the game limit or
+// when the sequential probability ratio test (SPRT) accepts a hypothesis.
+//
+// Usage: match_runner [options]
+//   --a <spec>, --b <spec>    engine settings, comma separated key=value:
+//                             depth=N, time=MS, eval=mobility|territory,
+//                             algo=minmax|pvs|mtdf, hash=MB, threads=N,
+//                             parallel=lazy|ybwc (default: depth=3)
+//   --games N                 maximum games (rounded up to pairs, default 1000)
+//   --concurrency N           games played at once (default: hardware threads)
+//   --opening-plies N         random plies before the engines take over (default 4)
+//   --seed N                  opening seed (default 1)
+//   --sprt ELO0 ELO1          stop when B - A is shown to be ELO0 or ELO1
+//   --alpha X, --beta X       SPRT error rates (default 0.05)
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct EngineConfig {
+    int depth = 3;
+    int timeMs = 0;
+    int hashMB = DEFAULT_HASH_MB;
+    int threads = 1;
+    EvalMode eval = EvalMode::MOBILITY;
+    SearchAlgorithm algorithm = SearchAlgorithm::NEGAMAX_PVS;
+    ParallelMode parallel = ParallelMode::LAZY_SMP;
+};
+
+// Parse "key=value,key=value"; returns false on an unknown key or value
+bool parseEngine(const std::string& spec, EngineConfig& config) {
+    bool depthSet = false;
+    std::stringstream items(spec);
+    std::string item;
+    while (std::getline(items, item, ',')) {
+        size_t eq = item.find('=');
+        if (eq == std::string::npos) {
+            return false;
+        }
+        std::string key = item.substr(0, eq);
+        std::string value = item.substr(eq + 1);
+        if (key == "depth") {
+            config.depth = std::atoi(value.c_str());
+            depthSet = true;
+        } else if (key == "time") {
+            config.timeMs = std::atoi(value.c_str());
+        } else if (key == "hash") {
+            config.hashMB = std::atoi(value.c_str());
+        } else if (key == "threads") {
+            config.threads = std::max(1, std::atoi(value.c_str()));
+        } else if (key == "eval" && (value == "mobility" || value == "territory")) {
+            config.eval = (value == "territory") ? EvalMode::TERRITORY : EvalMode::MOBILITY;
+        } else if (key == "algo" && value == "minmax") {
+            config.algorithm = SearchAlgorithm::MINMAX;
+        } else if (key == "algo" && value == "pvs") {
+            config.algorithm = SearchAlgorithm::NEGAMAX_PVS;
+        } else if (key == "algo" && value == "mtdf") {
+            config.algorithm = SearchAlgorithm::MTDF;
+        } else if (key == "parallel" && (value == "lazy" || value == "ybwc")) {
+            config.parallel = (value == "ybwc") ? ParallelMode::YBWC : ParallelMode::LAZY_SMP;
+        } else {
+            return false;
+        }
+    }
+
+    // A time budget alone means "as deep as the time allows"
+    if (config.timeMs > 0 && !depthSet) {
+        config.depth = MAX_SEARCH_DEPTH;
+    }
+    return config.depth > 0;
+}
+
+std::string describe(const EngineConfig& config) {
+    std::ostringstream text;
+    text << "depth=" << config.depth;
+    if (config.timeMs > 0) {
+        text << " time=" << config.timeMs << "ms";
+    }
+    text << " eval=" << (config.eval == EvalMode::TERRITORY ? "territory" : "mobility")
+         << " algo=" << (config.algorithm == SearchAlgorithm::MINMAX ? "minmax" :
+                         config.algorithm == SearchAlgorithm::MTDF ? "mtdf" : "pvs")
+         << " hash=" << config.hashMB << "MB threads=" << config.threads;
+    if (config.threads > 1) {
+        text << " parallel=" << (config.parallel == ParallelMode::YBWC ? "ybwc" : "lazy");
+    }
+    return text.str();
+}
+
+// One engine playing one color. Reused by a worker from game to game; the
+// table and ordering history are cleared so that games stay independent.
+struct Engine {
+    AI ai;
+    long long nodes = 0;
+    double seconds = 0.0;
+
+    Engine(const EngineConfig& config, Player player)
+        : ai(player, config.depth, config.hashMB, config.threads) {
+        ai.setTimeLimit(config.timeMs);
+        ai.setEvalMode(config.eval);
+        ai.setSearchAlgorithm(config.algorithm);
+        ai.setParallelMode(config.parallel);
+    }
+};
+
+// Both engines of a match, each able to play either color
+struct WorkerEngines {
+    Engine a1, a2, b1, b2;
+
+    WorkerEngines(const EngineConfig& a, const EngineConfig& b)
+        : a1(a, Player::PLAYER1), a2(a, Player::PLAYER2),
+          b1(b, Player::PLAYER1), b2(b, Player::PLAYER2) {}
+
+    // Move node counts and thinking time into the match totals
+    void collect(long long& nodesA, double& secondsA, long long& nodesB, double& secondsB) {
+        for (Engine* engine : {&a1, &a2, &b1, &b2}) {
+            bool isA = (engine == &a1 || engine == &a2);
+            (isA ? nodesA : nodesB) += engine->nodes;
+            (isA ? secondsA : secondsB) += engine->seconds;
+            engine->nodes = 0;
+            engine->seconds = 0.0;
+        }
+    }
+};
+
+// Random legal moves from the initial position; redrawn until the game is
+// still running afterwards
+Game randomOpening(int plies, std::mt19937& rng) {
+    while (true) {
+        Game game;
+        for (int i = 0; i < plies && !game.isGameOver(); i++) {
+            MoveList moves;
+            game.getBoard().generateMoves(game.getCurrentPlayer(), moves);
+            game.makeMove(moves[rng() % moves.size()]);
+        }
+        if (!game.isGameOver()) {
+            return game;
+        }
+    }
+}
+
+// Plays the game to the end; returns the winner
+Player playGame(Game game, Engine& player1, Engine& player2) {
+    while (!game.isGameOver()) {
+        Engine& engine = (game.getCurrentPlayer() == Player::PLAYER1) ? player1 : player2;
+        auto start = Clock::now();
+        Move move = engine.ai.getBestMove(game.getBoard());
+        engine.seconds += std::chrono::duration<double>(Clock::now() - start).count();
+        engine.nodes += engine.ai.getNodesEvaluated();
+        game.makeMove(move);
+    }
+    return game.getWinner();
+}
+
+// Results from B's point of view. The rules have no draws, so a pair
+// (both colors of one opening) scores 0, 1 or 2 wins.
+struct MatchStats {
+    long long wins = 0;
+    long long losses = 0;
+    long long pairs[3] = {};
+    long long nodesA = 0;
+    long long nodesB = 0;
+    double secondsA = 0.0;
+    double secondsB = 0.0;
+
+    long long games() const { return wins + losses; }
+    long long pairCount() const { return pairs[0] + pairs[1] + pairs[2]; }
+
+    // Mean score per game and the variance of a pair's mean score
+    double score() const {
+        long long n = pairCount();
+        return n ? (0.5 * pairs[1] + pairs[2]) / n : 0.5;
+    }
+
+    double pairVariance() const {
+        long long n = pairCount();
+        if (n == 0) {
+            return 0.0;
+        }
+        double s = score();
+        return (pairs[0] * s * s + pairs[1] * (0.5 - s) * (0.5 - s) + pairs[2] * (1.0 - s) * (1.0 - s)) / n;
+    }
+};
+
+// Expected score of the stronger side at an Elo difference, and back
+double eloToScore(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+double scoreToElo(double score) {
+    score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+// Log-likelihood ratio of H1 (elo1) against H0 (elo0) under the normal
+// approximation (GSPRT), with pairs as the independent samples
+double sprtLLR(const MatchStats& stats, double elo0, double elo1) {
+    double variance = stats.pairVariance();
+    if (variance <= 0.0) {
+        return 0.0;
+    }
+    double s0 = eloToScore(elo0);
+    double s1 = eloToScore(elo1);
+    return stats.pairCount() * (s1 - s0) * (2.0 * stats.score() - s0 - s1) / (2.0 * variance);
+}
+
+void printStats(std::ostream& out, const MatchStats& stats, double elapsed) {
+    long long pairs = stats.pairCount();
+    double elo = scoreToElo(stats.score());
+    double margin = 0.0;
+    if (pairs > 1) {
+        // 95% interval of the mean score, mapped to Elo
+        double error = 1.96 * std::sqrt(stats.pairVariance() / pairs);
+        margin = (scoreToElo(stats.score() + error) - scoreToElo(stats.score() - error)) / 2.0;
+    }
+
+    out << "Games " << stats.games() << ": B +" << stats.wins << " =0 -" << stats.losses
+        << " (" << 100.0 * stats.score() << "%), pairs 2/1/0: " << stats.pairs[2] << "/"
+        << stats.pairs[1] << "/" << stats.pairs[0] << std::endl;
+    out << "Elo B - A: " << elo << " +/- " << margin << " (95%)" << std::endl;
+    out << "Speed: " << stats.games() / elapsed << " games/sec, A "
+        << static_cast<long long>(stats.secondsA > 0 ? stats.nodesA / stats.secondsA : 0) << " nodes/sec, B "
+        << static_cast<long long>(stats.secondsB > 0 ? stats.nodesB / stats.secondsB : 0) << " nodes/sec"
+        << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    EngineConfig configA;
+    EngineConfig configB;
+    long long maxGames = 1000;
+    int concurrency = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int openingPlies = 4;
+    unsigned seed = 1;
+    bool sprt = false;
+    double elo0 = 0.0;
+    double elo1 = 0.0;
+    double alpha = 0.05;
+    double beta = 0.05;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--a" && hasValue) {
+            if (!parseEngine(argv[++i], configA)) {
+                std::cerr << "Invalid engine spec: " << argv[i] << std::endl;
+                return 2;
+            }
+        } else if (arg == "--b" && hasValue) {
+            if (!parseEngine(argv[++i], configB)) {
+                std::cerr << "Invalid engine spec: " << argv[i] << std::endl;
+                return 2;
+            }
+        } else if (arg == "--games" && hasValue) {
+            maxGames = std::atoll(argv[++i]);
+        } else if (arg == "--concurrency" && hasValue) {
+            concurrency = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--opening-plies" && hasValue) {
+            openingPlies = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (arg == "--sprt" && i + 2 < argc) {
+            sprt = true;
+            elo0 = std::atof(argv[++i]);
+            elo1 = std::atof(argv[++i]);
+        } else if (arg == "--alpha" && hasValue) {
+            alpha = std::atof(argv[++i]);
+        } else if (arg == "--beta" && hasValue) {
+            beta = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 2;
+        }
+    }
+
+    long long maxPairs = std::max(1LL, (maxGames + 1) / 2);
+    double lowerBound = std::log(beta / (1.0 - alpha));
+    double upperBound = std::log((1.0 - beta) / alpha);
+
+    std::ostream report(std::cout.rdbuf());
+    // Engine console log (debug builds) goes nowhere
+    NullBuffer nullBuffer;
+    std::cout.rdbuf(&nullBuffer);
+
+    report << "A: " << describe(configA) << std::endl;
+    report << "B: " << describe(configB) << std::endl;
+    report << "Up to " << maxPairs * 2 << " games, " << concurrency << " at once, "
+           << openingPlies << " opening plies";
+    if (sprt) {
+        report << ", SPRT elo0=" << elo0 << " elo1=" << elo1 << " alpha=" << alpha << " beta=" << beta;
+    }
+    report << std::endl;
+
+    MatchStats stats;
+    std::mutex statsLock;
+    std::atomic<long long> nextPair{0};
+    std::atomic<bool> stop{false};
+    int verdict = 0;    // -1 = H0 accepted, 1 = H1 accepted
+    auto start = Clock::now();
+    auto end = start;   // When the last counted pair finished
+
+    auto worker = [&]() {
+        WorkerEngines engines(configA, configB);
+        while (!stop) {
+            long long pair = nextPair++;
+            if (pair >= maxPairs) {
+                break;
+            }
+
+            // The opening depends only on the pair number, so runs are
+            // reproducible whatever the number of threads
+            std::mt19937 rng(seed * 1000003u + static_cast<unsigned>(pair));
+            Game opening = randomOpening(openingPlies, rng);
+
+            engines.a1.ai.clearHash();
+            engines.b2.ai.clearHash();
+            bool firstWin = playGame(opening, engines.a1, engines.b2) == Player::PLAYER2;
+            engines.b1.ai.clearHash();
+            engines.a2.ai.clearHash();
+            bool secondWin = playGame(opening, engines.b1, engines.a2) == Player::PLAYER1;
+
+            // Pairs still in flight when the SPRT stopped the match are
+            // dropped, so the report matches the verdict
+            std::lock_guard<std::mutex> guard(statsLock);
+            if (stop) {
+                break;
+            }
+            end = Clock::now();
+            int pairWins = (firstWin ? 1 : 0) + (secondWin ? 1 : 0);
+            stats.wins += pairWins;
+            stats.losses += 2 - pairWins;
+            stats.pairs[pairWins]++;
+            engines.collect(stats.nodesA, stats.secondsA, stats.nodesB, stats.secondsB);
+
+            if (stats.pairCount() % 50 == 0) {
+                double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+                std::cerr << stats.games() << " games, B +" << stats.wins << " -" << stats.losses
+                          << ", Elo " << scoreToElo(stats.score());
+                if (sprt) {
+                    std::cerr << ", LLR " << sprtLLR(stats, elo0, elo1);
+                }
+                std::cerr << " (" << stats.games() / elapsed << " games/sec)" << std::endl;
+            }
+
+            if (sprt) {
+                double llr = sprtLLR(stats, elo0, elo1);
+                if (llr >= upperBound || llr <= lowerBound) {
+                    verdict = (llr >= upperBound) ? 1 : -1;
+                    stop = true;
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < concurrency; i++) {
+        threads.emplace_back(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    double elapsed = std::chrono::duration<double>(end - start).count();
+
+    std::cout.rdbuf(report.rdbuf());
+    printStats(report, stats, elapsed);
+    if (sprt) {
+        report << "SPRT: LLR " << sprtLLR(stats, elo0, elo1) << " [" << lowerBound << ", " << upperBound << "] ";
+        if (verdict > 0) {
+            report << "H1 accepted (B is at least " << elo1 << " Elo stronger)" << std::endl;
+        } else if (verdict < 0) {
+            report << "H0 accepted (B is not " << elo1 << " Elo stronger)" << std::endl;
+        } else {
+            report << "inconclusive" << std::endl;
+        }
+    }
+    return 0;
+}
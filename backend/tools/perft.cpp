@@ -0,0 +1,270 @@
+#include "../include/board.h"
+#include "../include/notation.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Perft: the exact number of legal (move, remove) sequences of a given
+// length from a position, computed with the move generator. A position
+// where the side to move is stuck ends the game and has no sequences.
+//
+// The fast path generates moves into a MoveList and makes/unmakes them in
+// place; at the last ply moves are counted without generating them (bulk
+// counting), results may be cached in a hash table, and the root moves are
+// split between threads. --reference counts with getAllPossibleMoves and
+// applyMove on board copies instead, one move at a time, as the oracle for
+// either path.
+//
+// Usage: perft <depth> [options]
+//   --position <cells> <side>   position string (see notation.h) and the
+//                               side to move, 1 or 2
+//                               (default: the initial position, 1 to move)
+//   --threads N                 threads splitting the root (default: all)
+//   --hash MB                   perft hash table size (default 0 = off)
+//   --divide                    count per root move
+//   --reference                 slow reference count (single thread)
+//   --check                     run both and compare; exit code 1 on mismatch
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+Player otherPlayer(Player player) {
+    return (player == Player::PLAYER1) ? Player::PLAYER2 : Player::PLAYER1;
+}
+
+// Lock-free table of (position, depth) -> count. Same scheme as the
+// transposition table: each entry is data and key ^ data, so an entry
+// torn by a concurrent write fails the key check and reads as a miss.
+class PerftTable {
+private:
+    struct Entry {
+        std::atomic<uint64_t> keyXorData;
+        std::atomic<uint64_t> data;     // Count (bits 0-55), depth (bits 56-63)
+    };
+
+    std::unique_ptr<Entry[]> entries;
+    uint64_t indexMask = 0;
+
+    static constexpr uint64_t COUNT_MASK = (uint64_t(1) << 56) - 1;
+
+public:
+    explicit PerftTable(int sizeMB) {
+        if (sizeMB <= 0) {
+            return;
+        }
+        uint64_t count = 1;
+        while (count * 2 * sizeof(Entry) <= static_cast<uint64_t>(sizeMB) * 1024 * 1024) {
+            count *= 2;
+        }
+        entries.reset(new Entry[count]);
+        for (uint64_t i = 0; i < count; i++) {
+            entries[i].keyXorData.store(0, std::memory_order_relaxed);
+            entries[i].data.store(0, std::memory_order_relaxed);
+        }
+        indexMask = count - 1;
+    }
+
+    bool enabled() const { return entries != nullptr; }
+
+    bool probe(uint64_t key, int depth, uint64_t& count) const {
+        const Entry& entry = entries[key & indexMask];
+        uint64_t data = entry.data.load(std::memory_order_relaxed);
+        if ((entry.keyXorData.load(std::memory_order_relaxed) ^ data) != key ||
+            static_cast<int>(data >> 56) != depth) {
+            return false;
+        }
+        count = data & COUNT_MASK;
+        return true;
+    }
+
+    void store(uint64_t key, int depth, uint64_t count) {
+        if (count > COUNT_MASK) {
+            return;
+        }
+        Entry& entry = entries[key & indexMask];
+        uint64_t data = (static_cast<uint64_t>(depth) << 56) | count;
+        entry.keyXorData.store(key ^ data, std::memory_order_relaxed);
+        entry.data.store(data, std::memory_order_relaxed);
+    }
+};
+
+// Number of legal moves without generating them: every target square
+// combines with every removable cell except the target itself
+uint64_t countMoves(const Board& board, Player side) {
+    int opponentSq = board.getPlayerSquare(otherPlayer(side));
+    Bitboard removable = FULL_BOARD & ~board.getRemovedMask() & ~squareBit(opponentSq);
+    Bitboard targets = board.getMoveTargets(side);
+    return targets ? static_cast<uint64_t>(popCount(targets)) * (popCount(removable) - 1) : 0;
+}
+
+uint64_t perft(Board& board, Player side, int depth, PerftTable& table) {
+    if (depth == 1) {
+        return countMoves(board, side);
+    }
+
+    // Mirror images have equal counts and share the canonical key
+    uint64_t key = board.getCanonicalHash();
+    uint64_t count = 0;
+    if (table.enabled() && table.probe(key, depth, count)) {
+        return count;
+    }
+
+    MoveList moves;
+    board.generateMoves(side, moves);
+    for (const Move& move : moves) {
+        UndoInfo undo;
+        board.makeMove(move, side, undo);
+        count += perft(board, otherPlayer(side), depth - 1, table);
+        board.unmakeMove(side, undo);
+    }
+
+    if (table.enabled()) {
+        table.store(key, depth, count);
+    }
+    return count;
+}
+
+// Oracle: the original move list and applyMove, no shortcuts
+uint64_t perftReference(const Board& board, Player side, int depth) {
+    std::vector<Move> moves = board.getAllPossibleMoves(side);
+    if (depth == 1) {
+        return moves.size();
+    }
+
+    uint64_t count = 0;
+    for (const Move& move : moves) {
+        Board child = board.copy();
+        child.applyMove(move, side);
+        count += perftReference(child, otherPlayer(side), depth - 1);
+    }
+    return count;
+}
+
+// Count of every root move; threads take root moves in turn
+std::vector<uint64_t> perftRoot(const Board& board, Player side, int depth, int threads, PerftTable& table) {
+    MoveList moves;
+    board.generateMoves(side, moves);
+    std::vector<uint64_t> counts(moves.size(), 0);
+    if (depth == 1) {
+        std::fill(counts.begin(), counts.end(), 1);
+        return counts;
+    }
+
+    std::atomic<int> next{0};
+    auto worker = [&]() {
+        Board local = board;
+        for (int i = next++; i < moves.size(); i = next++) {
+            UndoInfo undo;
+            local.makeMove(moves[i], side, undo);
+            counts[i] = perft(local, otherPlayer(side), depth - 1, table);
+            local.unmakeMove(side, undo);
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int i = 1; i < threads; i++) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return counts;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: perft <depth> [--position <cells> <side>] [--threads N] [--hash MB]"
+                  << " [--divide] [--reference] [--check]" << std::endl;
+        return 2;
+    }
+
+    int maxDepth = std::atoi(argv[1]);
+    Board board;
+    Player side = Player::PLAYER1;
+    int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    int hashMB = 0;
+    bool divide = false;
+    bool reference = false;
+    bool check = false;
+
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--position" && i + 2 < argc) {
+            std::string sideText = argv[i + 2];
+            if ((sideText != "1" && sideText != "2") || !parsePosition(argv[i + 1], board)) {
+                std::cerr << "Invalid position" << std::endl;
+                return 2;
+            }
+            side = (sideText == "1") ? Player::PLAYER1 : Player::PLAYER2;
+            board.setSideToMove(side);
+            i += 2;
+        } else if (arg == "--threads" && i + 1 < argc) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--hash" && i + 1 < argc) {
+            hashMB = std::atoi(argv[++i]);
+        } else if (arg == "--divide") {
+            divide = true;
+        } else if (arg == "--reference") {
+            reference = true;
+        } else if (arg == "--check") {
+            check = true;
+        } else {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 2;
+        }
+    }
+    if (maxDepth < 1) {
+        std::cerr << "Depth must be at least 1" << std::endl;
+        return 2;
+    }
+
+    PerftTable table(hashMB);
+    bool mismatch = false;
+
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        uint64_t count = 0;
+        auto start = Clock::now();
+        if (reference) {
+            count = perftReference(board, side, depth);
+        } else {
+            std::vector<uint64_t> counts = perftRoot(board, side, depth, threads, table);
+            for (uint64_t c : counts) {
+                count += c;
+            }
+            if (divide && depth == maxDepth) {
+                MoveList moves;
+                board.generateMoves(side, moves);
+                for (int i = 0; i < moves.size(); i++) {
+                    std::cout << moveToString(moves[i]) << ": " << counts[i] << std::endl;
+                }
+            }
+        }
+        double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+        std::cout << "perft " << depth << ": " << count << " (" << seconds * 1000 << " ms, "
+                  << static_cast<long long>(seconds > 0 ? count / seconds : 0) << " leaves/sec)";
+        if (check && !reference) {
+            uint64_t expected = perftReference(board, side, depth);
+            if (expected != count) {
+                std::cout << " MISMATCH: reference " << expected;
+                mismatch = true;
+            } else {
+                std::cout << " ok";
+            }
+        }
+        std::cout << std::endl;
+    }
+
+    return mismatch ? 1 : 0;
+}
@@ -2,34 +2,36 @@ import 'dart:ffi' as ffi;
 import 'dart:io';
 import 'package:ffi/ffi.dart';
 
-// GameState structure (matches C++ struct)
-final class GameStateNative extends ffi.Struct {
-  @ffi.Array(49)
-  external ffi.Array<ffi.Int32> board;
+// StateBlock structure (matches C++ struct, STATE_BLOCK_LAYOUT 1)
+const int stateBlockLayout = 1;
 
-  @ffi.Int32()
-  external int player1Row;
+final class StateBlockNative extends ffi.Struct {
+  @ffi.Uint32()
+  external int layout;
 
-  @ffi.Int32()
-  external int player1Col;
+  @ffi.Uint32()
+  external int version;
 
-  @ffi.Int32()
-  external int player2Row;
+  @ffi.Array(49)
+  external ffi.Array<ffi.Uint8> cells;
 
-  @ffi.Int32()
-  external int player2Col;
+  @ffi.Uint8()
+  external int player1Square;
 
-  @ffi.Int32()
-  external int currentPlayer;
+  @ffi.Uint8()
+  external int player2Square;
 
-  @ffi.Int32()
-  external int turnCount;
+  @ffi.Uint8()
+  external int currentPlayer;
 
-  @ffi.Int32()
+  @ffi.Uint8()
   external int gameOver;
 
-  @ffi.Int32()
+  @ffi.Uint8()
   external int winner;
+
+  @ffi.Uint16()
+  external int turnCount;
 }
 
 // MoveData structure (matches C++ struct)
@@ -53,6 +55,33 @@ final class MoveDataNative extends ffi.Struct {
   external int removeCol;
 }
 
+// AISearchStatus structure (matches C++ struct)
+final class AISearchStatusNative extends ffi.Struct {
+  @ffi.Int32()
+  external int depth;
+
+  @ffi.Int32()
+  external int score;
+
+  @ffi.Int64()
+  external int nodes;
+
+  @ffi.Int32()
+  external int hasMove;
+
+  external MoveDataNative move;
+}
+
+// AI move copied out of native memory
+typedef AIMove = ({
+  int fromRow,
+  int fromCol,
+  int toRow,
+  int toCol,
+  int removeRow,
+  int removeCol,
+});
+
 // Function signatures
 typedef CreateGameNative = ffi.Pointer<ffi.Void> Function();
 typedef CreateGameDart = ffi.Pointer<ffi.Void> Function();
@@ -63,10 +92,10 @@ typedef DeleteGameDart = void Function(ffi.Pointer<ffi.Void>);
 typedef InitializeGameNative = ffi.Void Function(ffi.Pointer<ffi.Void>);
 typedef InitializeGameDart = void Function(ffi.Pointer<ffi.Void>);
 
-typedef GetGameStateNative = ffi.Void Function(
-    ffi.Pointer<ffi.Void>, ffi.Pointer<GameStateNative>);
-typedef GetGameStateDart = void Function(
-    ffi.Pointer<ffi.Void>, ffi.Pointer<GameStateNative>);
+typedef GetStateBlockNative = ffi.Pointer<StateBlockNative> Function(
+    ffi.Pointer<ffi.Void>);
+typedef GetStateBlockDart = ffi.Pointer<StateBlockNative> Function(
+    ffi.Pointer<ffi.Void>);
 
 typedef MakeMoveNative = ffi.Int32 Function(
     ffi.Pointer<ffi.Void>, ffi.Pointer<MoveDataNative>);
@@ -78,28 +107,70 @@ typedef GetAIMoveNative = ffi.Int32 Function(
 typedef GetAIMoveDart = int Function(
     ffi.Pointer<ffi.Void>, ffi.Pointer<MoveDataNative>);
 
-typedef IsGameOverNative = ffi.Int32 Function(ffi.Pointer<ffi.Void>);
-typedef IsGameOverDart = int Function(ffi.Pointer<ffi.Void>);
+typedef GetAIMoveTimedNative = ffi.Int32 Function(
+    ffi.Pointer<ffi.Void>, ffi.Int32, ffi.Pointer<MoveDataNative>);
+typedef GetAIMoveTimedDart = int Function(
+    ffi.Pointer<ffi.Void>, int, ffi.Pointer<MoveDataNative>);
+
+typedef ConfigureEngineNative = ffi.Void Function(
+    ffi.Pointer<ffi.Void>, ffi.Int32, ffi.Int32, ffi.Int32, ffi.Int32);
+typedef ConfigureEngineDart = void Function(
+    ffi.Pointer<ffi.Void>, int, int, int, int);
+
+typedef ClearEngineStateNative = ffi.Void Function(ffi.Pointer<ffi.Void>);
+typedef ClearEngineStateDart = void Function(ffi.Pointer<ffi.Void>);
 
-typedef GetWinnerNative = ffi.Int32 Function(ffi.Pointer<ffi.Void>);
-typedef GetWinnerDart = int Function(ffi.Pointer<ffi.Void>);
+typedef StartPonderNative = ffi.Int32 Function(ffi.Pointer<ffi.Void>);
+typedef StartPonderDart = int Function(ffi.Pointer<ffi.Void>);
+
+typedef StopPonderNative = ffi.Void Function(ffi.Pointer<ffi.Void>);
+typedef StopPonderDart = void Function(ffi.Pointer<ffi.Void>);
+
+typedef GetPonderStatsNative = ffi.Void Function(
+    ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Int32>, ffi.Pointer<ffi.Int32>);
+typedef GetPonderStatsDart = void Function(
+    ffi.Pointer<ffi.Void>, ffi.Pointer<ffi.Int32>, ffi.Pointer<ffi.Int32>);
+
+typedef StartAISearchNative = ffi.Int32 Function(
+    ffi.Pointer<ffi.Void>, ffi.Int32, ffi.Int32);
+typedef StartAISearchDart = int Function(ffi.Pointer<ffi.Void>, int, int);
+
+typedef PollAISearchNative = ffi.Int32 Function(
+    ffi.Pointer<ffi.Void>, ffi.Pointer<AISearchStatusNative>);
+typedef PollAISearchDart = int Function(
+    ffi.Pointer<ffi.Void>, ffi.Pointer<AISearchStatusNative>);
+
+typedef CancelAISearchNative = ffi.Void Function(ffi.Pointer<ffi.Void>);
+typedef CancelAISearchDart = void Function(ffi.Pointer<ffi.Void>);
+
+typedef LoadOpeningBookNative = ffi.Int32 Function(ffi.Pointer<Utf8>);
+typedef LoadOpeningBookDart = int Function(ffi.Pointer<Utf8>);
 
-typedef GetCurrentPlayerNative = ffi.Int32 Function(ffi.Pointer<ffi.Void>);
-typedef GetCurrentPlayerDart = int Function(ffi.Pointer<ffi.Void>);
 
 class GameFFI {
   late ffi.DynamicLibrary _dylib;
   late ffi.Pointer<ffi.Void> _gameInstance;
+  bool _disposed = false;
+
+  // Game state owned by the native game, read in place
+  late ffi.Pointer<StateBlockNative> _stateBlock;
 
   late CreateGameDart _createGame;
   late DeleteGameDart _deleteGame;
   late InitializeGameDart _initializeGame;
-  late GetGameStateDart _getGameState;
+  late GetStateBlockDart _getStateBlock;
   late MakeMoveDart _makeMove;
   late GetAIMoveDart _getAIMove;
-  late IsGameOverDart _isGameOver;
-  late GetWinnerDart _getWinner;
-  late GetCurrentPlayerDart _getCurrentPlayer;
+  late GetAIMoveTimedDart _getAIMoveTimed;
+  late ConfigureEngineDart _configureEngine;
+  late ClearEngineStateDart _clearEngineState;
+  late StartPonderDart _startPonder;
+  late StopPonderDart _stopPonder;
+  late GetPonderStatsDart _getPonderStats;
+  late StartAISearchDart _startAISearch;
+  late PollAISearchDart _pollAISearch;
+  late CancelAISearchDart _cancelAISearch;
+  late LoadOpeningBookDart _loadOpeningBook;
 
   GameFFI() {
     // Load the DLL
@@ -116,8 +187,8 @@ class GameFFI {
     _initializeGame = _dylib
         .lookup<ffi.NativeFunction<InitializeGameNative>>('initializeGame')
         .asFunction();
-    _getGameState = _dylib
-        .lookup<ffi.NativeFunction<GetGameStateNative>>('getGameState')
+    _getStateBlock = _dylib
+        .lookup<ffi.NativeFunction<GetStateBlockNative>>('getStateBlock')
         .asFunction();
     _makeMove = _dylib
         .lookup<ffi.NativeFunction<MakeMoveNative>>('makeMove')
@@ -125,18 +196,48 @@ class GameFFI {
     _getAIMove = _dylib
         .lookup<ffi.NativeFunction<GetAIMoveNative>>('getAIMove')
         .asFunction();
-    _isGameOver = _dylib
-        .lookup<ffi.NativeFunction<IsGameOverNative>>('isGameOver')
+    _getAIMoveTimed = _dylib
+        .lookup<ffi.NativeFunction<GetAIMoveTimedNative>>('getAIMoveTimed')
+        .asFunction();
+    _configureEngine = _dylib
+        .lookup<ffi.NativeFunction<ConfigureEngineNative>>('configureEngine')
         .asFunction();
-    _getWinner = _dylib
-        .lookup<ffi.NativeFunction<GetWinnerNative>>('getWinner')
+    _clearEngineState = _dylib
+        .lookup<ffi.NativeFunction<ClearEngineStateNative>>('clearEngineState')
         .asFunction();
-    _getCurrentPlayer = _dylib
-        .lookup<ffi.NativeFunction<GetCurrentPlayerNative>>('getCurrentPlayer')
+    _startPonder = _dylib
+        .lookup<ffi.NativeFunction<StartPonderNative>>('startPonder')
+        .asFunction();
+    _stopPonder = _dylib
+        .lookup<ffi.NativeFunction<StopPonderNative>>('stopPonder')
+        .asFunction();
+    _getPonderStats = _dylib
+        .lookup<ffi.NativeFunction<GetPonderStatsNative>>('getPonderStats')
+        .asFunction();
+    _startAISearch = _dylib
+        .lookup<ffi.NativeFunction<StartAISearchNative>>('startAISearch')
+        .asFunction();
+    _pollAISearch = _dylib
+        .lookup<ffi.NativeFunction<PollAISearchNative>>('pollAISearch')
+        .asFunction();
+    _cancelAISearch = _dylib
+        .lookup<ffi.NativeFunction<CancelAISearchNative>>('cancelAISearch')
+        .asFunction();
+    _loadOpeningBook = _dylib
+        .lookup<ffi.NativeFunction<LoadOpeningBookNative>>('loadOpeningBook')
         .asFunction();
 
     // Create game instance
     _gameInstance = _createGame();
+    _stateBlock = _getStateBlock(_gameInstance);
+    if (_stateBlock.ref.layout != stateBlockLayout) {
+      throw StateError('Game engine state layout ${_stateBlock.ref.layout} '
+          'does not match $stateBlockLayout');
+    }
+
+    // Opening book shipped next to the DLL (optional; the library maps it
+    // once and later games share it)
+    _loadBook();
   }
 
   String _getLibraryPath() {
@@ -146,36 +247,26 @@ class GameFFI {
     return '$exeDir\\libgame_engine.dll';
   }
 
+  void _loadBook() {
+    final exeDir = File(Platform.resolvedExecutable).parent.path;
+    final bookPath = '$exeDir\\opening_book.bin';
+    if (!File(bookPath).existsSync()) return;
+
+    final pathPtr = bookPath.toNativeUtf8();
+    _loadOpeningBook(pathPtr);
+    malloc.free(pathPtr);
+  }
+
   void initialize() {
     _initializeGame(_gameInstance);
   }
 
-  Map<String, dynamic> getGameState() {
-    final statePtr = calloc<GameStateNative>();
-    _getGameState(_gameInstance, statePtr);
-    final state = statePtr.ref;
+  // Current state, read in place (no copy, no allocation). Valid until the
+  // next call that changes the game.
+  StateBlockNative get state => _stateBlock.ref;
 
-    // Convert board array to List
-    final boardList = <int>[];
-    for (int i = 0; i < 49; i++) {
-      boardList.add(state.board[i]);
-    }
-
-    final result = {
-      'board': boardList,
-      'player1Row': state.player1Row,
-      'player1Col': state.player1Col,
-      'player2Row': state.player2Row,
-      'player2Col': state.player2Col,
-      'currentPlayer': state.currentPlayer,
-      'turnCount': state.turnCount,
-      'gameOver': state.gameOver,
-      'winner': state.winner,
-    };
-
-    calloc.free(statePtr);
-    return result;
-  }
+  // Changes whenever the state does; equal versions mean nothing to redraw
+  int get stateVersion => _stateBlock.ref.version;
 
   bool makeMove(int fromRow, int fromCol, int toRow, int toCol,
       int removeRow, int removeCol) {
@@ -206,19 +297,108 @@ class GameFFI {
     return null;
   }
 
+  // AI move found by iterative deepening within timeLimitMs
+  AIMove? getAIMoveTimed(int timeLimitMs) {
+    final movePtr = calloc<MoveDataNative>();
+    try {
+      if (_getAIMoveTimed(_gameInstance, timeLimitMs, movePtr) != 1) {
+        return null;
+      }
+      return _copyMove(movePtr.ref);
+    } finally {
+      calloc.free(movePtr);
+    }
+  }
+
+  // Engine settings of this game (the engine is kept between AI turns)
+  void configureEngine(
+      {int depth = 2, int timeLimitMs = 0, int hashSizeMB = 16, int threads = 1}) {
+    _configureEngine(_gameInstance, depth, timeLimitMs, hashSizeMB, threads);
+  }
+
+  // Forget what the engine learned in earlier searches
+  void clearEngineState() {
+    _clearEngineState(_gameInstance);
+  }
+
+  // AI move searched in an engine thread. The search is polled between
+  // frames, so the UI stays responsive; it is cancelled after maxWait and
+  // its best move so far is used.
+  Future<AIMove?> searchAIMove(int timeLimitMs,
+      {Duration maxWait = const Duration(seconds: 10)}) async {
+    if (_startAISearch(_gameInstance, 0, timeLimitMs) != 1) return null;
+
+    final statusPtr = calloc<AISearchStatusNative>();
+    final stopwatch = Stopwatch()..start();
+    try {
+      while (_pollAISearch(_gameInstance, statusPtr) == 1) {
+        if (stopwatch.elapsed >= maxWait) {
+          _cancelAISearch(_gameInstance);
+        } else {
+          await Future.delayed(const Duration(milliseconds: 16));
+          // The game may have been deleted while waiting
+          if (_disposed) return null;
+        }
+      }
+
+      final status = statusPtr.ref;
+      if (status.hasMove != 1) return null;
+      return _copyMove(status.move);
+    } finally {
+      calloc.free(statusPtr);
+    }
+  }
+
+  // .ref is a view of native memory, so copy before the memory is freed
+  AIMove _copyMove(MoveDataNative move) => (
+        fromRow: move.fromRow,
+        fromCol: move.fromCol,
+        toRow: move.toRow,
+        toCol: move.toCol,
+        removeRow: move.removeRow,
+        removeCol: move.removeCol,
+      );
+
+  void cancelAISearch() {
+    _cancelAISearch(_gameInstance);
+  }
+
+  // Search the predicted reply in the background during the human's turn.
+  // The human's next makeMove either hands that search to the next AI move
+  // (hit) or stops it (miss).
+  bool startPonder() {
+    return _startPonder(_gameInstance) == 1;
+  }
+
+  void stopPonder() {
+    _stopPonder(_gameInstance);
+  }
+
+  // Ponder hits and misses so far
+  ({int hits, int misses}) getPonderStats() {
+    final hitsPtr = calloc<ffi.Int32>();
+    final missesPtr = calloc<ffi.Int32>();
+    _getPonderStats(_gameInstance, hitsPtr, missesPtr);
+    final stats = (hits: hitsPtr.value, misses: missesPtr.value);
+    calloc.free(hitsPtr);
+    calloc.free(missesPtr);
+    return stats;
+  }
+
   bool isGameOver() {
-    return _isGameOver(_gameInstance) == 1;
+    return _stateBlock.ref.gameOver == 1;
   }
 
   int getWinner() {
-    return _getWinner(_gameInstance);
+    return _stateBlock.ref.winner;
   }
 
   int getCurrentPlayer() {
-    return _getCurrentPlayer(_gameInstance);
+    return _stateBlock.ref.currentPlayer;
   }
 
   void dispose() {
+    _disposed = true;
     _deleteGame(_gameInstance);
   }
 }
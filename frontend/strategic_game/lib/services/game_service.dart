@@ -3,6 +3,9 @@ import '../models/game_state.dart';
 import '../models/position.dart';
 import 'game_ffi.dart';
 
+// Thinking time per AI move
+const int aiMoveTimeMs = 1000;
+
 class GameService extends ChangeNotifier {
   late GameFFI _ffi;
   GameState _gameState = GameState.initial();
@@ -13,6 +16,8 @@ class GameService extends ChangeNotifier {
   Position? _lastAIFrom;
   Position? _lastAITo;
   Position? _lastAIRemoved;
+  // Engine state version _gameState was built from
+  int _syncedVersion = -1;
 
   GameState get gameState => _gameState;
   Position? get selectedCell => _selectedCell;
@@ -40,35 +45,38 @@ class GameService extends ChangeNotifier {
 
   void _syncState() {
     try {
-      final stateData = _ffi.getGameState();
-      final boardList = stateData['board'] as List<int>;
+      // The engine bumps the version on every change; an unchanged version
+      // means the current GameState is still up to date
+      final version = _ffi.stateVersion;
+      if (version != _syncedVersion) {
+        final state = _ffi.state;
 
-      // Convert board (1D array to 2D)
-      final board = List.generate(
-        7,
-        (row) => List.generate(
+        // Convert board (1D array to 2D)
+        final board = List.generate(
           7,
-          (col) {
-            final index = row * 7 + col;
-            final cellValue = boardList[index];
-            return CellState.values[cellValue];
-          },
-        ),
-      );
+          (row) => List.generate(
+            7,
+            (col) => CellState.values[state.cells[row * 7 + col]],
+          ),
+        );
 
-      // Create new game state
-      _gameState = GameState(
-        board: board,
-        player1Position: Position(stateData['player1Row'], stateData['player1Col']),
-        player2Position: Position(stateData['player2Row'], stateData['player2Col']),
-        currentPlayer:
-            stateData['currentPlayer'] == 1 ? Player.player1 : Player.player2,
-        turnCount: stateData['turnCount'],
-        gameOver: stateData['gameOver'] == 1,
-        winner: stateData['gameOver'] == 1
-            ? (stateData['winner'] == 1 ? Player.player1 : Player.player2)
-            : null,
-      );
+        // Create new game state
+        _gameState = GameState(
+          board: board,
+          player1Position:
+              Position(state.player1Square ~/ 7, state.player1Square % 7),
+          player2Position:
+              Position(state.player2Square ~/ 7, state.player2Square % 7),
+          currentPlayer:
+              state.currentPlayer == 1 ? Player.player1 : Player.player2,
+          turnCount: state.turnCount,
+          gameOver: state.gameOver == 1,
+          winner: state.gameOver == 1
+              ? (state.winner == 1 ? Player.player1 : Player.player2)
+              : null,
+        );
+        _syncedVersion = version;
+      }
 
       _errorMessage = null;
       notifyListeners();
@@ -198,11 +206,10 @@ class GameService extends ChangeNotifier {
     notifyListeners();
 
     try {
-      // Run AI computation in isolate to prevent UI freeze
       await Future.delayed(const Duration(milliseconds: 200));
 
-      final aiMove = await Future(() => _ffi.getAIMove())
-          .timeout(const Duration(seconds: 10));
+      // The engine searches in its own thread; the UI keeps running
+      final aiMove = await _ffi.searchAIMove(aiMoveTimeMs);
 
       if (aiMove != null) {
         _lastAIFrom = Position(aiMove.fromRow, aiMove.fromCol);
@@ -220,6 +227,8 @@ class GameService extends ChangeNotifier {
 
         if (success) {
           _syncState();
+          // Keep searching while the human thinks
+          _ffi.startPonder();
           // Keep AI move highlight for a moment
           await Future.delayed(const Duration(milliseconds: 1500));
           _lastAIFrom = null;